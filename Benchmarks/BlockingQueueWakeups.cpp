@@ -0,0 +1,135 @@
+#include "BlockingQueue.h"
+#include "Queue.h"
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+#include <sys/resource.h>
+
+// A producer sends bursts of items with a pause after each burst, as bursty
+// network or log traffic does; one consumer handles them. Compares the
+// classic mutex + condition_variable around exemplar::Queue (one wait and
+// one notify per item) with BlockingQueue::wait_dequeue and
+// wait_dequeue_bulk, and reports the context switches and CPU time the
+// whole process spent per 1000 items.
+//
+// Usage: BlockingQueueWakeups [bursts] [burst_size] [pause_us]
+
+namespace {
+
+constexpr std::size_t k_batch = 256;
+
+struct Config {
+    std::size_t bursts;
+    std::size_t burst_size;
+    std::chrono::microseconds pause;
+};
+
+class ConditionQueue {
+public:
+    void enqueue(std::uint64_t value) {
+        {
+            std::lock_guard lock(mutex_);
+            queue_.enqueue(value);
+        }
+        ready_.notify_one();
+    }
+
+    std::uint64_t wait_dequeue() {
+        std::unique_lock lock(mutex_);
+        ready_.wait(lock, [&] { return !queue_.empty(); });
+        const std::uint64_t value = queue_.front();
+        queue_.dequeue();
+        return value;
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    exemplar::Queue<std::uint64_t> queue_;
+};
+
+struct Usage {
+    double context_switches;
+    double cpu_us;
+};
+
+Usage usage_now() {
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    const auto us = [](const timeval& time) { return 1e6 * static_cast<double>(time.tv_sec) + time.tv_usec; };
+    return {static_cast<double>(usage.ru_nvcsw + usage.ru_nivcsw), us(usage.ru_utime) + us(usage.ru_stime)};
+}
+
+// Runs producer against consume(), which returns how many items it took in
+// one call, and prints the usage per 1000 items.
+template <typename Fifo, typename Consume>
+void run(const char* label, const Config& config, Fifo& fifo, Consume consume) {
+    const std::size_t total = config.bursts * config.burst_size;
+    const Usage before = usage_now();
+
+    std::thread producer([&] {
+        for (std::size_t burst = 0; burst < config.bursts; ++burst) {
+            for (std::size_t i = 0; i < config.burst_size; ++i) {
+                fifo.enqueue(burst * config.burst_size + i);
+            }
+            std::this_thread::sleep_for(config.pause);
+        }
+    });
+
+    std::size_t calls = 0;
+    for (std::size_t received = 0; received < total; ++calls) {
+        received += consume();
+    }
+    producer.join();
+
+    const Usage after = usage_now();
+    const double per_thousand = 1000.0 / static_cast<double>(total);
+    std::cout << label << ": " << (after.context_switches - before.context_switches) * per_thousand
+              << " context switches, " << (after.cpu_us - before.cpu_us) * per_thousand << " us CPU, "
+              << static_cast<double>(calls) * per_thousand << " consumer calls per 1000 items" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Config config{};
+    config.bursts = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000;
+    config.burst_size = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 64;
+    config.pause = std::chrono::microseconds(argc > 3 ? std::strtoll(argv[3], nullptr, 10) : 200);
+
+    std::cout << "bursts: " << config.bursts << " x " << config.burst_size << " items, pause " << config.pause.count()
+              << " us" << std::endl;
+
+    {
+        ConditionQueue fifo;
+        run("mutex + condition_variable Queue", config, fifo, [&] {
+            fifo.wait_dequeue();
+            return std::size_t{1};
+        });
+    }
+    {
+        exemplar::BlockingQueue<std::uint64_t> fifo;
+        run("BlockingQueue::wait_dequeue     ", config, fifo, [&] {
+            std::uint64_t value = 0;
+            fifo.wait_dequeue(value);
+            return std::size_t{1};
+        });
+    }
+    {
+        exemplar::BlockingQueue<std::uint64_t> fifo;
+        std::array<std::uint64_t, k_batch> batch{};
+        run("BlockingQueue::wait_dequeue_bulk", config, fifo, [&] {
+            return fifo.wait_dequeue_bulk(batch.data(), batch.size(), std::chrono::milliseconds(100));
+        });
+    }
+
+    return 0;
+}
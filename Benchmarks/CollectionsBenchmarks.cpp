@@ -0,0 +1,769 @@
+// Both libraries have a ResizingArray.h and a SinglyLinkedList.h, so every
+// header is included through its directory.
+#include "Collections/DoubleLinkedList.h"
+#include "Collections/ResizingArray.h"
+#include "Collections/SinglyLinkedList.h"
+#include "ExemplarCollections/BinarySearchTree.h"
+#include "ExemplarCollections/ConcurrentHashMap.h"
+#include "ExemplarCollections/DoublyLinkedList.h"
+#include "ExemplarCollections/FlatHashMap.h"
+#include "ExemplarCollections/HashMap.h"
+#include "ExemplarCollections/Heap.h"
+#include "ExemplarCollections/Queue.h"
+#include "ExemplarCollections/ResizingArray.h"
+#include "ExemplarCollections/RingQueue.h"
+#include "ExemplarCollections/SinglyLinkedList.h"
+#include "ExemplarCollections/Stack.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <list>
+#include <optional>
+#include <queue>
+#include <random>
+#include <set>
+#include <stack>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Runs the same workloads against the containers in ExemplarCollections and
+// Collections and against the std containers they stand in for, and prints
+// one JSON document with ns/op for every (family, container, workload, size).
+//
+// Containers are grouped into families; compare results within a family.
+// A workload is only registered for containers that support it: e.g. the
+// exemplar lists have no iteration API and the Collections containers
+// cannot be copied.
+//
+// Build with optimizations (-DCMAKE_BUILD_TYPE=Release); the "optimized"
+// field of the output records whether that was the case. Sizes near 1e8 need
+// several GB of memory for the list and tree families.
+//
+// Usage: CollectionsBenchmarks [--min-size N] [--max-size N] [--min-time SECONDS]
+//                              [--filter TEXT] [--output FILE]
+//   Sizes are the powers of ten from --min-size to --max-size
+//   (default 1e2 to 1e6; 1e8 is the largest accepted). Each benchmark is
+//   repeated until it has run for --min-time seconds (default 0.1).
+//   --filter keeps benchmarks whose "family/container/workload" contains TEXT.
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t k_max_size = 100'000'000;
+
+// Keeps results alive so the compiler cannot drop the measured work.
+volatile std::uint64_t g_sink = 0;
+
+void consume(std::uint64_t value) { g_sink = g_sink + value; }
+
+// Inputs shared by every benchmark of one size.
+struct Input {
+    std::size_t size = 0;
+    std::vector<int> keys;             // size distinct keys, inserted first
+    std::vector<int> fresh_keys;       // size further keys, distinct from keys
+    std::vector<int> probe_keys;       // size keys drawn from keys at random
+    std::vector<std::uint32_t> probe_indexes; // size random positions in [0, size)
+};
+
+// A bijection on 32-bit values, so distinct indexes give distinct keys.
+std::uint32_t scramble(std::uint32_t value) {
+    value ^= value >> 16;
+    value *= 0x7FEB352DU;
+    value ^= value >> 15;
+    value *= 0x846CA68BU;
+    value ^= value >> 16;
+    return value;
+}
+
+Input make_input(std::size_t size) {
+    Input input;
+    input.size = size;
+    input.keys.resize(size);
+    input.fresh_keys.resize(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        input.keys[i] = static_cast<int>(scramble(static_cast<std::uint32_t>(i)));
+        input.fresh_keys[i] = static_cast<int>(scramble(static_cast<std::uint32_t>(size + i)));
+    }
+
+    std::mt19937_64 rng(size);
+    std::uniform_int_distribution<std::uint32_t> position(0, static_cast<std::uint32_t>(size - 1));
+    input.probe_keys.resize(size);
+    input.probe_indexes.resize(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        input.probe_indexes[i] = position(rng);
+        input.probe_keys[i] = input.keys[position(rng)];
+    }
+    return input;
+}
+
+// One timed run: how long the measured section took and how many
+// container operations it performed.
+struct Sample {
+    double nanoseconds = 0;
+    std::size_t operations = 0;
+};
+
+template <typename Fn>
+double time_ns(Fn&& fn) {
+    const auto start = Clock::now();
+    fn();
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+// Sequence family: contiguous, indexable, grows at the back.
+
+template <typename Container>
+Sample sequence_push_back(const Input& input) {
+    Container container;
+    const double ns = time_ns([&] {
+        for (int key : input.keys) {
+            container.push_back(key);
+        }
+    });
+    return {ns, input.size};
+}
+
+template <typename Container>
+Sample sequence_push_pop(const Input& input) {
+    Container container;
+    const double ns = time_ns([&] {
+        for (int key : input.keys) {
+            container.push_back(key);
+        }
+        while (!container.empty()) {
+            consume(static_cast<std::uint64_t>(container.back()));
+            container.pop_back();
+        }
+    });
+    return {ns, 2 * input.size};
+}
+
+template <typename Container>
+Container filled_sequence(const Input& input) {
+    Container container;
+    for (int key : input.keys) {
+        container.push_back(key);
+    }
+    return container;
+}
+
+template <typename Container>
+Sample sequence_random_lookup(const Input& input) {
+    const Container container = filled_sequence<Container>(input);
+    std::uint64_t sum = 0;
+    const double ns = time_ns([&] {
+        for (std::uint32_t index : input.probe_indexes) {
+            sum += static_cast<std::uint64_t>(container[index]);
+        }
+    });
+    consume(sum);
+    return {ns, input.size};
+}
+
+template <typename Container>
+Sample sequence_iteration(const Input& input) {
+    const Container container = filled_sequence<Container>(input);
+    std::uint64_t sum = 0;
+    const double ns = time_ns([&] {
+        for (std::size_t i = 0; i < container.size(); ++i) {
+            sum += static_cast<std::uint64_t>(container[i]);
+        }
+    });
+    consume(sum);
+    return {ns, input.size};
+}
+
+template <typename Container>
+Sample copy_workload(const Container& source, std::size_t size) {
+    // The copy is destroyed outside the measured section.
+    std::optional<Container> copy;
+    const double ns = time_ns([&] { copy.emplace(source); });
+    return {ns, size};
+}
+
+template <typename Container>
+Sample sequence_copy(const Input& input) {
+    return copy_workload(filled_sequence<Container>(input), input.size);
+}
+
+// FIFO family: push at the back, pop at the front.
+// Adapters name the operations, since every container spells them differently.
+
+struct ExemplarQueueOps {
+    using Container = exemplar::Queue<int>;
+    static void push(Container& c, int v) { c.enqueue(v); }
+    static int pop(Container& c) {
+        const int v = c.front();
+        c.dequeue();
+        return v;
+    }
+};
+
+struct ExemplarRingQueueOps {
+    using Container = exemplar::RingQueue<int>;
+    static void push(Container& c, int v) { c.enqueue(v); }
+    static int pop(Container& c) {
+        const int v = c.front();
+        c.dequeue();
+        return v;
+    }
+};
+
+template <typename List>
+struct ListOps {
+    using Container = List;
+    static void push(Container& c, int v) { c.push_back(v); }
+    static int pop(Container& c) {
+        const int v = c.front();
+        c.pop_front();
+        return v;
+    }
+};
+
+// collections::SinglyLinkedList::push_back walks the whole list;
+// push_back_with_tail is its O(1) append.
+struct CollectionsSinglyLinkedListOps {
+    using Container = collections::SinglyLinkedList<int>;
+    static void push(Container& c, int v) { c.push_back_with_tail(v); }
+    static int pop(Container& c) {
+        const int v = c.front();
+        c.pop_front();
+        return v;
+    }
+};
+
+template <typename Ops>
+Sample fifo_push_pop(const Input& input) {
+    typename Ops::Container container;
+    const double ns = time_ns([&] {
+        for (int key : input.keys) {
+            Ops::push(container, key);
+        }
+        for (std::size_t i = 0; i < input.size; ++i) {
+            consume(static_cast<std::uint64_t>(Ops::pop(container)));
+        }
+    });
+    return {ns, 2 * input.size};
+}
+
+template <typename Ops>
+Sample fifo_copy(const Input& input) {
+    typename Ops::Container container;
+    for (int key : input.keys) {
+        Ops::push(container, key);
+    }
+    return copy_workload(container, input.size);
+}
+
+Sample std_list_iteration(const Input& input) {
+    const std::list<int> list(input.keys.begin(), input.keys.end());
+    std::uint64_t sum = 0;
+    const double ns = time_ns([&] {
+        for (int value : list) {
+            sum += static_cast<std::uint64_t>(value);
+        }
+    });
+    consume(sum);
+    return {ns, input.size};
+}
+
+// LIFO family.
+
+template <typename Container>
+Sample lifo_push_pop(const Input& input) {
+    Container container;
+    const double ns = time_ns([&] {
+        for (int key : input.keys) {
+            container.push(key);
+        }
+        while (!container.empty()) {
+            consume(static_cast<std::uint64_t>(container.top()));
+            container.pop();
+        }
+    });
+    return {ns, 2 * input.size};
+}
+
+template <typename Container>
+Sample lifo_copy(const Input& input) {
+    Container container;
+    for (int key : input.keys) {
+        container.push(key);
+    }
+    return copy_workload(container, input.size);
+}
+
+// Priority queue family. exemplar::Heap is a min-heap, so the std baseline
+// uses std::greater to pop in the same order.
+
+using StdMinPriorityQueue = std::priority_queue<int, std::vector<int>, std::greater<int>>;
+
+template <typename Container>
+Container filled_heap(const Input& input) {
+    Container heap;
+    for (int key : input.keys) {
+        heap.push(key);
+    }
+    return heap;
+}
+
+// Steady-state scheduling: each step removes the top and adds a new key.
+template <typename Container>
+Sample heap_churn(const Input& input) {
+    Container heap = filled_heap<Container>(input);
+    const double ns = time_ns([&] {
+        for (int key : input.fresh_keys) {
+            consume(static_cast<std::uint64_t>(heap.top()));
+            heap.pop();
+            heap.push(key);
+        }
+    });
+    return {ns, 2 * input.size};
+}
+
+template <typename Container>
+Sample heap_copy(const Input& input) {
+    return copy_workload(filled_heap<Container>(input), input.size);
+}
+
+// Ordered set family.
+
+bool set_insert(exemplar::BinarySearchTree<int>& set, int key) { return set.insert(key); }
+bool set_insert(std::set<int>& set, int key) { return set.insert(key).second; }
+
+bool set_contains(const exemplar::BinarySearchTree<int>& set, int key) { return set.contains(key); }
+bool set_contains(const std::set<int>& set, int key) { return set.contains(key); }
+
+template <typename Container>
+Container filled_set(const Input& input) {
+    Container set;
+    for (int key : input.keys) {
+        set_insert(set, key);
+    }
+    return set;
+}
+
+template <typename Container>
+Sample set_insert_workload(const Input& input) {
+    Container set;
+    const double ns = time_ns([&] {
+        for (int key : input.keys) {
+            set_insert(set, key);
+        }
+    });
+    return {ns, input.size};
+}
+
+template <typename Container>
+Sample set_random_lookup(const Input& input) {
+    const Container set = filled_set<Container>(input);
+    std::uint64_t hits = 0;
+    const double ns = time_ns([&] {
+        for (int key : input.probe_keys) {
+            hits += set_contains(set, key) ? 1 : 0;
+        }
+    });
+    consume(hits);
+    return {ns, input.size};
+}
+
+// Erases every original key in insertion order while inserting a fresh one,
+// so the size stays constant and the tree keeps changing shape.
+template <typename Container>
+Sample set_erase_churn(const Input& input) {
+    Container set = filled_set<Container>(input);
+    const double ns = time_ns([&] {
+        for (std::size_t i = 0; i < input.size; ++i) {
+            set.erase(input.keys[i]);
+            set_insert(set, input.fresh_keys[i]);
+        }
+    });
+    return {ns, 2 * input.size};
+}
+
+Sample bst_iteration(const Input& input) {
+    const auto set = filled_set<exemplar::BinarySearchTree<int>>(input);
+    std::uint64_t sum = 0;
+    // in_order() is the tree's only traversal; it materializes a vector.
+    const double ns = time_ns([&] {
+        for (int value : set.in_order()) {
+            sum += static_cast<std::uint64_t>(value);
+        }
+    });
+    consume(sum);
+    return {ns, input.size};
+}
+
+Sample std_set_iteration(const Input& input) {
+    const auto set = filled_set<std::set<int>>(input);
+    std::uint64_t sum = 0;
+    const double ns = time_ns([&] {
+        for (int value : set) {
+            sum += static_cast<std::uint64_t>(value);
+        }
+    });
+    consume(sum);
+    return {ns, input.size};
+}
+
+template <typename Container>
+Sample set_copy(const Input& input) {
+    return copy_workload(filled_set<Container>(input), input.size);
+}
+
+// Hash map family.
+
+template <typename Map>
+void map_insert(Map& map, int key, int value) {
+    map.insert_or_assign(key, value);
+}
+
+template <typename Map>
+bool map_contains(const Map& map, int key) {
+    return map.contains(key);
+}
+
+template <typename Map>
+Map make_map() {
+    return Map();
+}
+
+template <>
+exemplar::HashMap<int, int> make_map() {
+    return exemplar::HashMap<int, int>(exemplar::RehashPolicy::all_at_once);
+}
+
+// A second HashMap type name so both rehash policies can be registered.
+struct IncrementalHashMap : exemplar::HashMap<int, int> {
+    IncrementalHashMap() : exemplar::HashMap<int, int>(exemplar::RehashPolicy::incremental) {}
+};
+
+template <typename Map>
+void fill_map(Map& map, const Input& input) {
+    for (int key : input.keys) {
+        map_insert(map, key, key);
+    }
+}
+
+template <typename Map>
+Sample map_insert_workload(const Input& input) {
+    Map map = make_map<Map>();
+    const double ns = time_ns([&] { fill_map(map, input); });
+    return {ns, input.size};
+}
+
+template <typename Map>
+Sample map_random_lookup(const Input& input) {
+    Map map = make_map<Map>();
+    fill_map(map, input);
+    std::uint64_t hits = 0;
+    const double ns = time_ns([&] {
+        for (int key : input.probe_keys) {
+            hits += map_contains(map, key) ? 1 : 0;
+        }
+    });
+    consume(hits);
+    return {ns, input.size};
+}
+
+template <typename Map>
+Sample map_erase_churn(const Input& input) {
+    Map map = make_map<Map>();
+    fill_map(map, input);
+    const double ns = time_ns([&] {
+        for (std::size_t i = 0; i < input.size; ++i) {
+            map.erase(input.keys[i]);
+            map_insert(map, input.fresh_keys[i], input.fresh_keys[i]);
+        }
+    });
+    return {ns, 2 * input.size};
+}
+
+Sample hash_map_iteration(const Input& input) {
+    auto map = make_map<exemplar::HashMap<int, int>>();
+    fill_map(map, input);
+    std::uint64_t sum = 0;
+    const double ns = time_ns([&] { map.for_each([&](int, int value) { sum += static_cast<std::uint64_t>(value); }); });
+    consume(sum);
+    return {ns, input.size};
+}
+
+Sample unordered_map_iteration(const Input& input) {
+    std::unordered_map<int, int> map;
+    fill_map(map, input);
+    std::uint64_t sum = 0;
+    const double ns = time_ns([&] {
+        for (const auto& [key, value] : map) {
+            sum += static_cast<std::uint64_t>(value);
+        }
+    });
+    consume(sum);
+    return {ns, input.size};
+}
+
+template <typename Map>
+Sample map_copy(const Input& input) {
+    Map map = make_map<Map>();
+    fill_map(map, input);
+    return copy_workload(map, input.size);
+}
+
+// Registry and driver.
+
+struct Benchmark {
+    std::string family;
+    std::string container;
+    std::string workload;
+    std::function<Sample(const Input&)> run;
+
+    [[nodiscard]] std::string id() const { return family + "/" + container + "/" + workload; }
+};
+
+std::vector<Benchmark> all_benchmarks() {
+    std::vector<Benchmark> b;
+    auto add = [&](std::string family, std::string container, std::string workload, Sample (*run)(const Input&)) {
+        b.push_back({std::move(family), std::move(container), std::move(workload), run});
+    };
+
+    using ExemplarArray = exemplar::ResizingArray<int>;
+    using CollectionsArray = collections::ResizingArray<int>;
+    for (auto [name, push_back, lookup, iteration] : {
+             std::tuple{"exemplar::ResizingArray", &sequence_push_back<ExemplarArray>,
+                        &sequence_random_lookup<ExemplarArray>, &sequence_iteration<ExemplarArray>},
+             std::tuple{"collections::ResizingArray", &sequence_push_back<CollectionsArray>,
+                        &sequence_random_lookup<CollectionsArray>, &sequence_iteration<CollectionsArray>},
+             std::tuple{"std::vector", &sequence_push_back<std::vector<int>>,
+                        &sequence_random_lookup<std::vector<int>>, &sequence_iteration<std::vector<int>>},
+             std::tuple{"std::deque", &sequence_push_back<std::deque<int>>, &sequence_random_lookup<std::deque<int>>,
+                        &sequence_iteration<std::deque<int>>},
+         }) {
+        add("sequence", name, "push_back", push_back);
+        add("sequence", name, "random_lookup", lookup);
+        add("sequence", name, "iteration", iteration);
+    }
+    // collections::ResizingArray has neither pop_back nor a copy constructor.
+    add("sequence", "exemplar::ResizingArray", "push_pop", &sequence_push_pop<ExemplarArray>);
+    add("sequence", "exemplar::ResizingArray", "copy", &sequence_copy<ExemplarArray>);
+    add("sequence", "std::vector", "push_pop", &sequence_push_pop<std::vector<int>>);
+    add("sequence", "std::vector", "copy", &sequence_copy<std::vector<int>>);
+    add("sequence", "std::deque", "push_pop", &sequence_push_pop<std::deque<int>>);
+    add("sequence", "std::deque", "copy", &sequence_copy<std::deque<int>>);
+
+    add("fifo", "exemplar::Queue", "push_pop", &fifo_push_pop<ExemplarQueueOps>);
+    add("fifo", "exemplar::Queue", "copy", &fifo_copy<ExemplarQueueOps>);
+    add("fifo", "exemplar::RingQueue", "push_pop", &fifo_push_pop<ExemplarRingQueueOps>);
+    add("fifo", "exemplar::RingQueue", "copy", &fifo_copy<ExemplarRingQueueOps>);
+    add("fifo", "exemplar::SinglyLinkedList", "push_pop", &fifo_push_pop<ListOps<exemplar::SinglyLinkedList<int>>>);
+    add("fifo", "exemplar::SinglyLinkedList", "copy", &fifo_copy<ListOps<exemplar::SinglyLinkedList<int>>>);
+    add("fifo", "exemplar::DoublyLinkedList", "push_pop", &fifo_push_pop<ListOps<exemplar::DoublyLinkedList<int>>>);
+    add("fifo", "exemplar::DoublyLinkedList", "copy", &fifo_copy<ListOps<exemplar::DoublyLinkedList<int>>>);
+    // The Collections lists own raw or unique pointers without copy support.
+    add("fifo", "collections::SinglyLinkedList", "push_pop", &fifo_push_pop<CollectionsSinglyLinkedListOps>);
+    add("fifo", "collections::DoubleLinkedList", "push_pop",
+        &fifo_push_pop<ListOps<collections::DoubleLinkedList<int>>>);
+    add("fifo", "std::list", "push_pop", &fifo_push_pop<ListOps<std::list<int>>>);
+    add("fifo", "std::list", "copy", &fifo_copy<ListOps<std::list<int>>>);
+    add("fifo", "std::list", "iteration", &std_list_iteration);
+    add("fifo", "std::deque", "push_pop", &fifo_push_pop<ListOps<std::deque<int>>>);
+    add("fifo", "std::deque", "copy", &fifo_copy<ListOps<std::deque<int>>>);
+
+    add("lifo", "exemplar::Stack", "push_pop", &lifo_push_pop<exemplar::Stack<int>>);
+    add("lifo", "exemplar::Stack", "copy", &lifo_copy<exemplar::Stack<int>>);
+    add("lifo", "std::stack<std::deque>", "push_pop", &lifo_push_pop<std::stack<int>>);
+    add("lifo", "std::stack<std::deque>", "copy", &lifo_copy<std::stack<int>>);
+    add("lifo", "std::stack<std::vector>", "push_pop", &lifo_push_pop<std::stack<int, std::vector<int>>>);
+    add("lifo", "std::stack<std::vector>", "copy", &lifo_copy<std::stack<int, std::vector<int>>>);
+
+    add("priority_queue", "exemplar::Heap", "push_pop", &lifo_push_pop<exemplar::Heap<int>>);
+    add("priority_queue", "exemplar::Heap", "erase_churn", &heap_churn<exemplar::Heap<int>>);
+    add("priority_queue", "exemplar::Heap", "copy", &heap_copy<exemplar::Heap<int>>);
+    add("priority_queue", "std::priority_queue", "push_pop", &lifo_push_pop<StdMinPriorityQueue>);
+    add("priority_queue", "std::priority_queue", "erase_churn", &heap_churn<StdMinPriorityQueue>);
+    add("priority_queue", "std::priority_queue", "copy", &heap_copy<StdMinPriorityQueue>);
+
+    using Tree = exemplar::BinarySearchTree<int>;
+    add("ordered_set", "exemplar::BinarySearchTree", "insert", &set_insert_workload<Tree>);
+    add("ordered_set", "exemplar::BinarySearchTree", "random_lookup", &set_random_lookup<Tree>);
+    add("ordered_set", "exemplar::BinarySearchTree", "erase_churn", &set_erase_churn<Tree>);
+    add("ordered_set", "exemplar::BinarySearchTree", "iteration", &bst_iteration);
+    add("ordered_set", "exemplar::BinarySearchTree", "copy", &set_copy<Tree>);
+    add("ordered_set", "std::set", "insert", &set_insert_workload<std::set<int>>);
+    add("ordered_set", "std::set", "random_lookup", &set_random_lookup<std::set<int>>);
+    add("ordered_set", "std::set", "erase_churn", &set_erase_churn<std::set<int>>);
+    add("ordered_set", "std::set", "iteration", &std_set_iteration);
+    add("ordered_set", "std::set", "copy", &set_copy<std::set<int>>);
+
+    using ChainedMap = exemplar::HashMap<int, int>;
+    using FlatMap = exemplar::FlatHashMap<int, int>;
+    using ShardedMap = exemplar::ConcurrentHashMap<int, int>;
+    using StdMap = std::unordered_map<int, int>;
+    for (auto [name, insert, lookup, churn] : {
+             std::tuple{"exemplar::HashMap", &map_insert_workload<ChainedMap>, &map_random_lookup<ChainedMap>,
+                        &map_erase_churn<ChainedMap>},
+             std::tuple{"exemplar::HashMap(incremental)", &map_insert_workload<IncrementalHashMap>,
+                        &map_random_lookup<IncrementalHashMap>, &map_erase_churn<IncrementalHashMap>},
+             std::tuple{"exemplar::FlatHashMap", &map_insert_workload<FlatMap>, &map_random_lookup<FlatMap>,
+                        &map_erase_churn<FlatMap>},
+             std::tuple{"exemplar::ConcurrentHashMap", &map_insert_workload<ShardedMap>,
+                        &map_random_lookup<ShardedMap>, &map_erase_churn<ShardedMap>},
+             std::tuple{"std::unordered_map", &map_insert_workload<StdMap>, &map_random_lookup<StdMap>,
+                        &map_erase_churn<StdMap>},
+         }) {
+        add("hash_map", name, "insert", insert);
+        add("hash_map", name, "random_lookup", lookup);
+        add("hash_map", name, "erase_churn", churn);
+    }
+    // FlatHashMap has no traversal API; ConcurrentHashMap can be neither
+    // traversed nor copied.
+    add("hash_map", "exemplar::HashMap", "iteration", &hash_map_iteration);
+    add("hash_map", "std::unordered_map", "iteration", &unordered_map_iteration);
+    add("hash_map", "exemplar::HashMap", "copy", &map_copy<ChainedMap>);
+    add("hash_map", "exemplar::HashMap(incremental)", "copy", &map_copy<IncrementalHashMap>);
+    add("hash_map", "exemplar::FlatHashMap", "copy", &map_copy<FlatMap>);
+    add("hash_map", "std::unordered_map", "copy", &map_copy<StdMap>);
+
+    return b;
+}
+
+struct Options {
+    std::size_t min_size = 100;
+    std::size_t max_size = 1'000'000;
+    double min_time_s = 0.1;
+    std::string filter;
+    std::string output;
+};
+
+std::size_t parse_size(const std::string& text) {
+    // Accepts "1000000" as well as "1e6".
+    const double value = std::stod(text);
+    if (value < 1 || value > static_cast<double>(k_max_size)) {
+        throw std::invalid_argument("size must be between 1 and 1e8: " + text);
+    }
+    return static_cast<std::size_t>(value);
+}
+
+Options parse_options(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view flag = argv[i];
+        if (i + 1 >= argc) {
+            throw std::invalid_argument("missing value for " + std::string(flag));
+        }
+
+        const std::string value = argv[++i];
+        if (flag == "--min-size") {
+            options.min_size = parse_size(value);
+        } else if (flag == "--max-size") {
+            options.max_size = parse_size(value);
+        } else if (flag == "--min-time") {
+            options.min_time_s = std::stod(value);
+        } else if (flag == "--filter") {
+            options.filter = value;
+        } else if (flag == "--output") {
+            options.output = value;
+        } else {
+            throw std::invalid_argument("unknown option " + std::string(flag));
+        }
+    }
+    return options;
+}
+
+std::vector<std::size_t> sizes_between(std::size_t min_size, std::size_t max_size) {
+    std::vector<std::size_t> sizes;
+    for (std::size_t size = 1; size <= max_size; size *= 10) {
+        if (size >= min_size) {
+            sizes.push_back(size);
+        }
+    }
+    return sizes;
+}
+
+std::string json_escape(std::string_view text) {
+    std::string out;
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+        }
+        out += c;
+    }
+    return out;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    try {
+        options = parse_options(argc, argv);
+    } catch (const std::exception& error) {
+        std::cerr << error.what() << std::endl;
+        return 1;
+    }
+
+    std::ofstream file;
+    if (!options.output.empty()) {
+        file.open(options.output);
+        if (!file) {
+            std::cerr << "cannot open " << options.output << std::endl;
+            return 1;
+        }
+    }
+    std::ostream json(options.output.empty() ? std::cout.rdbuf() : file.rdbuf());
+
+    std::vector<Benchmark> benchmarks = all_benchmarks();
+    std::erase_if(benchmarks, [&](const Benchmark& benchmark) {
+        return benchmark.id().find(options.filter) == std::string::npos;
+    });
+
+#ifdef __OPTIMIZE__
+    constexpr bool optimized = true;
+#else
+    constexpr bool optimized = false;
+#endif
+
+    json << "{\n  \"optimized\": " << (optimized ? "true" : "false") << ",\n  \"min_time_s\": " << options.min_time_s
+         << ",\n  \"results\": [";
+
+    bool first = true;
+    for (std::size_t size : sizes_between(options.min_size, options.max_size)) {
+        const Input input = make_input(size);
+        for (const Benchmark& benchmark : benchmarks) {
+            std::cerr << benchmark.id() << " n=" << size << std::endl;
+
+            double best_ns_per_op = 0;
+            double total_ns = 0;
+            std::size_t total_operations = 0;
+            std::size_t runs = 0;
+            while (runs == 0 || total_ns < options.min_time_s * 1e9) {
+                const Sample sample = benchmark.run(input);
+                const double ns_per_op = sample.nanoseconds / static_cast<double>(sample.operations);
+                best_ns_per_op = runs == 0 ? ns_per_op : std::min(best_ns_per_op, ns_per_op);
+                total_ns += sample.nanoseconds;
+                total_operations += sample.operations;
+                ++runs;
+            }
+
+            json << (first ? "\n" : ",\n") << "    {\"family\": \"" << json_escape(benchmark.family)
+                 << "\", \"container\": \"" << json_escape(benchmark.container) << "\", \"workload\": \""
+                 << json_escape(benchmark.workload) << "\", \"size\": " << size << ", \"runs\": " << runs
+                 << ", \"ns_per_op_best\": " << best_ns_per_op
+                 << ", \"ns_per_op_mean\": " << total_ns / static_cast<double>(total_operations) << "}";
+            first = false;
+        }
+    }
+
+    json << "\n  ]\n}" << std::endl;
+    return 0;
+}
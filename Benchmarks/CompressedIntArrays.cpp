@@ -0,0 +1,128 @@
+#include "DeltaVarintArray.h"
+#include "PackedIntArray.h"
+#include "ResizingArray.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+
+// Memory and access time of compressed integer arrays against a plain
+// ResizingArray<std::uint32_t>:
+// - random 20-bit IDs in PackedIntArray: random reads and a sequential sum
+// - sorted IDs with small gaps in DeltaVarintArray: a sequential sum
+//
+// Usage: CompressedIntArrays [element_count]
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double elapsed_ms(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+void report(const char* label, std::size_t bytes, std::size_t count) {
+    std::cout << label << ": " << static_cast<double>(bytes) / (1 << 20) << " MiB ("
+              << static_cast<double>(bytes) * 8 / static_cast<double>(count) << " bits/value)" << std::endl;
+}
+
+template <typename Array>
+void time_random_reads(const char* label, const Array& array, const exemplar::ResizingArray<std::uint32_t>& indices) {
+    std::uint64_t checksum = 0;
+    const auto start = Clock::now();
+    for (std::size_t i = 0; i < indices.size(); ++i) {
+        checksum += array[indices[i]];
+    }
+    const double ms = elapsed_ms(start);
+    std::cout << label << " random reads: " << ms * 1e6 / static_cast<double>(indices.size()) << " ns/read ["
+              << checksum << "]" << std::endl;
+}
+
+template <typename Sum>
+void time_scan(const char* label, std::size_t count, Sum&& sum) {
+    const auto start = Clock::now();
+    const std::uint64_t checksum = sum();
+    const double ms = elapsed_ms(start);
+    std::cout << label << " sequential sum: " << ms * 1e6 / static_cast<double>(count) << " ns/value [" << checksum
+              << "]" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 50'000'000;
+    std::mt19937 rng(42);
+
+    // Random 20-bit IDs.
+    {
+        exemplar::ResizingArray<std::uint32_t> plain;
+        auto packed = exemplar::PackedIntArray<std::uint32_t>::for_max_value((1u << 20) - 1);
+        plain.reserve(count);
+        packed.reserve(count);
+        std::uniform_int_distribution<std::uint32_t> id(0, (1u << 20) - 1);
+        for (std::size_t i = 0; i < count; ++i) {
+            const std::uint32_t value = id(rng);
+            plain.push_back(value);
+            packed.push_back(value);
+        }
+
+        exemplar::ResizingArray<std::uint32_t> indices;
+        std::uniform_int_distribution<std::uint32_t> index(0, static_cast<std::uint32_t>(count - 1));
+        for (std::size_t i = 0; i < 10'000'000; ++i) {
+            indices.push_back(index(rng));
+        }
+
+        report("ResizingArray<uint32_t>", plain.capacity() * sizeof(std::uint32_t), count);
+        report("PackedIntArray (20 bits)", packed.memory_bytes(), count);
+        time_random_reads("ResizingArray<uint32_t>", plain, indices);
+        time_random_reads("PackedIntArray", packed, indices);
+        time_scan("ResizingArray<uint32_t>", count, [&] {
+            std::uint64_t sum = 0;
+            for (std::size_t i = 0; i < plain.size(); ++i) {
+                sum += plain[i];
+            }
+            return sum;
+        });
+        time_scan("PackedIntArray", count, [&] {
+            std::uint64_t sum = 0;
+            for (std::size_t i = 0; i < packed.size(); ++i) {
+                sum += packed[i];
+            }
+            return sum;
+        });
+    }
+
+    // Sorted IDs with gaps of 0-63.
+    {
+        exemplar::ResizingArray<std::uint32_t> plain;
+        exemplar::DeltaVarintArray delta;
+        plain.reserve(count);
+        std::uniform_int_distribution<std::uint32_t> gap(0, 63);
+        std::uint32_t value = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            value += gap(rng);
+            plain.push_back(value);
+            delta.push_back(value);
+        }
+
+        report("ResizingArray<uint32_t> sorted", plain.capacity() * sizeof(std::uint32_t), count);
+        report("DeltaVarintArray", delta.memory_bytes(), count);
+        time_scan("ResizingArray<uint32_t> sorted", count, [&] {
+            std::uint64_t sum = 0;
+            for (std::size_t i = 0; i < plain.size(); ++i) {
+                sum += plain[i];
+            }
+            return sum;
+        });
+        time_scan("DeltaVarintArray", count, [&] {
+            std::uint64_t sum = 0;
+            delta.for_each([&](std::uint32_t v) { sum += v; });
+            return sum;
+        });
+    }
+
+    return 0;
+}
@@ -0,0 +1,77 @@
+#include "ConcurrentSegmentedArray.h"
+#include "ResizingArray.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Measures append throughput as writer threads are added, each pushing its
+// share of a fixed number of log records into one shared array. Compares
+// ConcurrentSegmentedArray (a fetch_add per append) with a ResizingArray
+// behind a std::mutex.
+//
+// Usage: ConcurrentAppend [max_threads] [records]
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Record {
+    std::uint64_t timestamp;
+    std::uint32_t source;
+    std::uint32_t code;
+};
+
+class LockedArray {
+public:
+    void push_back(const Record& record) {
+        std::lock_guard lock(mutex_);
+        records_.push_back(record);
+    }
+
+private:
+    std::mutex mutex_;
+    exemplar::ResizingArray<Record> records_;
+};
+
+template <typename Array>
+double appends_per_second(std::size_t thread_count, std::size_t records) {
+    Array array;
+    const std::size_t per_thread = records / thread_count;
+
+    const auto start = Clock::now();
+    std::vector<std::thread> writers;
+    for (std::size_t t = 0; t < thread_count; ++t) {
+        writers.emplace_back([&, t] {
+            for (std::size_t i = 0; i < per_thread; ++i) {
+                array.push_back(Record{i, static_cast<std::uint32_t>(t), static_cast<std::uint32_t>(i & 0xff)});
+            }
+        });
+    }
+    for (auto& writer : writers) {
+        writer.join();
+    }
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return static_cast<double>(per_thread * thread_count) / seconds;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t hardware = std::thread::hardware_concurrency() == 0 ? 1 : std::thread::hardware_concurrency();
+    const std::size_t max_threads = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : hardware;
+    const std::size_t records = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 10'000'000;
+
+    std::cout << "writers, ConcurrentSegmentedArray appends/s, mutex ResizingArray appends/s" << std::endl;
+    for (std::size_t threads = 1; threads <= max_threads; threads *= 2) {
+        std::cout << threads << ", " << appends_per_second<exemplar::ConcurrentSegmentedArray<Record>>(threads, records)
+                  << ", " << appends_per_second<LockedArray>(threads, records) << std::endl;
+    }
+
+    return 0;
+}
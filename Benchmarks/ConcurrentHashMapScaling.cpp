@@ -0,0 +1,107 @@
+#include "ConcurrentHashMap.h"
+#include "HashMap.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+// Measures throughput of a mixed workload, 80% get and 20%
+// insert_or_assign on random keys, as threads are added. Compares the
+// sharded ConcurrentHashMap with a HashMap behind one global std::mutex.
+//
+// Usage: ConcurrentHashMapScaling [max_threads] [milliseconds_per_run]
+
+namespace {
+
+constexpr int k_key_count = 1 << 20;
+constexpr std::uint32_t k_read_percent = 80;
+
+class GlobalMutexMap {
+public:
+    std::optional<int> get(int key) const {
+        std::lock_guard lock(mutex_);
+        return map_.get(key);
+    }
+
+    bool insert_or_assign(int key, int value) {
+        std::lock_guard lock(mutex_);
+        return map_.insert_or_assign(key, value);
+    }
+
+private:
+    mutable std::mutex mutex_;
+    exemplar::HashMap<int, int> map_;
+};
+
+// xorshift32: cheap enough not to show up next to a map operation.
+std::uint32_t next_random(std::uint32_t& state) noexcept {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+template <typename Map>
+double ops_per_second(Map& map, std::size_t thread_count, std::chrono::milliseconds duration) {
+    std::atomic<bool> stop{false};
+    std::atomic<long long> total_ops{0};
+
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < thread_count; ++t) {
+        threads.emplace_back([&, t] {
+            std::uint32_t state = static_cast<std::uint32_t>(t) * 0x9E3779B9u + 1;
+            long long ops = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                const std::uint32_t random = next_random(state);
+                const int key = static_cast<int>(random % k_key_count);
+                if (random / k_key_count % 100 < k_read_percent) {
+                    // Both maps take a lock per lookup, so it cannot be optimized out.
+                    (void)map.get(key);
+                } else {
+                    map.insert_or_assign(key, static_cast<int>(ops));
+                }
+                ++ops;
+            }
+            total_ops += ops;
+        });
+    }
+
+    std::this_thread::sleep_for(duration);
+    stop = true;
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    return static_cast<double>(total_ops.load()) / std::chrono::duration<double>(duration).count();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t max_threads = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 32;
+    const auto duration = std::chrono::milliseconds(argc > 2 ? std::strtoll(argv[2], nullptr, 10) : 500);
+
+    exemplar::ConcurrentHashMap<int, int> sharded;
+    GlobalMutexMap locked;
+    for (int key = 0; key < k_key_count; ++key) {
+        sharded.insert_or_assign(key, key);
+        locked.insert_or_assign(key, key);
+    }
+
+    std::cout << "threads, ConcurrentHashMap ops/s, global mutex HashMap ops/s, speedup" << std::endl;
+    for (std::size_t threads = 1; threads <= max_threads; threads *= 2) {
+        const double sharded_ops = ops_per_second(sharded, threads, duration);
+        const double locked_ops = ops_per_second(locked, threads, duration);
+        std::cout << threads << ", " << sharded_ops << ", " << locked_ops << ", " << sharded_ops / locked_ops
+                  << std::endl;
+    }
+
+    return 0;
+}
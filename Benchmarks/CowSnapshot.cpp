@@ -0,0 +1,62 @@
+#include "CowResizingArray.h"
+#include "ResizingArray.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+// A writer updates one element of a large array, then hands a snapshot of
+// it to each of R readers, round after round. With ResizingArray that is R
+// deep copies per round. With CowResizingArray the hand-offs are reference
+// count increments, and the next update copies the buffer once, because the
+// readers still hold the old one.
+//
+// Usage: CowSnapshot [element_count] [rounds]
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+template <typename Array>
+double us_per_round(std::size_t count, std::size_t rounds, std::size_t readers) {
+    Array array;
+    for (std::size_t i = 0; i < count; ++i) {
+        array.push_back(static_cast<std::int64_t>(i));
+    }
+    std::vector<Array> snapshots(readers);
+
+    const auto start = Clock::now();
+    for (std::size_t round = 0; round < rounds; ++round) {
+        if constexpr (requires { array.set(0, std::int64_t{}); }) {
+            array.set(round % count, static_cast<std::int64_t>(round));
+        } else {
+            array[round % count] = static_cast<std::int64_t>(round);
+        }
+
+        for (Array& snapshot : snapshots) {
+            snapshot = array;
+        }
+    }
+    const double elapsed_us = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+    return elapsed_us / static_cast<double>(rounds);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+    const std::size_t rounds = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 200;
+
+    std::cout << "elements: " << count << " x int64_t" << std::endl;
+    for (std::size_t readers : {1, 4, 16}) {
+        const double deep = us_per_round<exemplar::ResizingArray<std::int64_t>>(count, rounds, readers);
+        const double cow = us_per_round<exemplar::CowResizingArray<std::int64_t>>(count, rounds, readers);
+        std::cout << readers << " readers: ResizingArray " << deep << " us/round, CowResizingArray " << cow
+                  << " us/round (x" << deep / cow << ")" << std::endl;
+    }
+
+    return 0;
+}
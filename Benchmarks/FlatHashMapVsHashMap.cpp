@@ -0,0 +1,94 @@
+#include "FlatHashMap.h"
+#include "HashMap.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+// Compares the open-addressing FlatHashMap with the chained HashMap on
+// tables of a million keys and more: growing from empty, lookups of keys
+// that are present (in a different order than inserted), and lookups of
+// keys that are absent.
+//
+// Usage: FlatHashMapVsHashMap [entry_count]
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+volatile long long g_sink = 0;
+
+struct Timings {
+    double insert_ns = 0;
+    double hit_ns = 0;
+    double miss_ns = 0;
+};
+
+double ns_since(Clock::time_point start) {
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+template <typename Map>
+Timings run(const std::vector<int>& keys, const std::vector<int>& hits, const std::vector<int>& misses) {
+    Timings timings;
+    Map map;
+
+    auto start = Clock::now();
+    for (int key : keys) {
+        map.insert_or_assign(key, key);
+    }
+    timings.insert_ns = ns_since(start) / static_cast<double>(keys.size());
+
+    long long sum = 0;
+    start = Clock::now();
+    for (int key : hits) {
+        sum += *map.get(key);
+    }
+    timings.hit_ns = ns_since(start) / static_cast<double>(hits.size());
+
+    start = Clock::now();
+    for (int key : misses) {
+        sum += map.contains(key) ? 1 : 0;
+    }
+    timings.miss_ns = ns_since(start) / static_cast<double>(misses.size());
+
+    g_sink = g_sink + sum;
+    return timings;
+}
+
+void print(const char* name, const Timings& timings, const Timings& baseline) {
+    std::cout << name << ", " << timings.insert_ns << ", " << timings.hit_ns << ", " << timings.miss_ns << ", "
+              << baseline.hit_ns / timings.hit_ns << "x, " << baseline.miss_ns / timings.miss_ns << "x" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t entry_count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4'000'000;
+
+    // Even keys are inserted; odd keys probe for misses.
+    std::mt19937 rng(42);
+    std::vector<int> keys(entry_count);
+    for (auto& key : keys) {
+        key = static_cast<int>(rng() & ~1u);
+    }
+    std::vector<int> misses(entry_count);
+    for (auto& key : misses) {
+        key = static_cast<int>(rng() | 1u);
+    }
+    std::vector<int> hits(keys);
+    std::shuffle(hits.begin(), hits.end(), rng);
+
+    const Timings chained = run<exemplar::HashMap<int, int>>(keys, hits, misses);
+    const Timings flat = run<exemplar::FlatHashMap<int, int>>(keys, hits, misses);
+
+    std::cout << "map, insert ns/key, hit ns/key, miss ns/key, hit speedup, miss speedup" << std::endl;
+    print("HashMap", chained, chained);
+    print("FlatHashMap", flat, chained);
+
+    return 0;
+}
@@ -0,0 +1,71 @@
+#include "HashMap.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <span>
+#include <vector>
+
+// Compares one-at-a-time HashMap::get with the prefetching HashMap::get_many
+// for a range of batch sizes, on a table meant to be larger than the
+// last-level cache.
+//
+// Usage: HashMapBatchLookup [entry_count]
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t entry_count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4'000'000;
+
+    std::mt19937 rng(42);
+    std::vector<int> keys(entry_count);
+    for (auto& key : keys) {
+        key = static_cast<int>(rng());
+    }
+
+    exemplar::HashMap<int, int> map;
+    map.reserve(entry_count);
+    for (int key : keys) {
+        map.insert_or_assign(key, key);
+    }
+
+    // Look keys up in a different order than they were inserted.
+    std::vector<int> probes(keys.begin(), keys.end());
+    std::shuffle(probes.begin(), probes.end(), rng);
+
+    std::cout << "batch, get ns/key, get_many ns/key, speedup" << std::endl;
+    for (std::size_t batch : {1, 8, 16, 64, 256, 1024}) {
+        std::vector<std::optional<int>> out(batch);
+        long long checksum = 0;
+
+        auto start = Clock::now();
+        for (std::size_t base = 0; base + batch <= probes.size(); base += batch) {
+            for (std::size_t i = 0; i < batch; ++i) {
+                out[i] = map.get(probes[base + i]);
+            }
+            checksum += *out[0];
+        }
+        const double single_ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+        start = Clock::now();
+        for (std::size_t base = 0; base + batch <= probes.size(); base += batch) {
+            map.get_many(std::span<const int>(probes).subspan(base, batch), out);
+            checksum -= *out[0];
+        }
+        const double batched_ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+        const double lookups = static_cast<double>(probes.size() / batch * batch);
+        std::cout << batch << ", " << single_ns / lookups << ", " << batched_ns / lookups << ", " << single_ns / batched_ns
+                  << (checksum == 0 ? "" : " (checksum mismatch)") << std::endl;
+    }
+
+    return 0;
+}
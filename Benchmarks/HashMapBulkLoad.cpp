@@ -0,0 +1,65 @@
+#include "HashMap.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <utility>
+#include <vector>
+
+// Compares three ways of loading a table whose final size is known up front:
+// inserting one by one from the default 8 buckets, reserve() then inserting,
+// and the range constructor (which reserves internally).
+//
+// Usage: HashMapBulkLoad [entry_count]
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+template <typename Load>
+void run(const char* label, Load&& load) {
+    const auto start = Clock::now();
+    const exemplar::HashMap<int, int> map = load();
+    const double elapsed_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    std::cout << label << ": " << elapsed_ms << " ms"
+              << " (" << map.size() << " entries, " << map.bucket_count() << " buckets)" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t entry_count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4'000'000;
+
+    std::mt19937 rng(42);
+    std::vector<std::pair<int, int>> entries(entry_count);
+    for (auto& [key, value] : entries) {
+        key = static_cast<int>(rng());
+        value = key;
+    }
+
+    std::cout << "Loading " << entry_count << " random int keys" << std::endl;
+
+    run("insert_or_assign", [&] {
+        exemplar::HashMap<int, int> map;
+        for (const auto& [key, value] : entries) {
+            map.insert_or_assign(key, value);
+        }
+        return map;
+    });
+
+    run("reserve + insert_or_assign", [&] {
+        exemplar::HashMap<int, int> map;
+        map.reserve(entries.size());
+        for (const auto& [key, value] : entries) {
+            map.insert_or_assign(key, value);
+        }
+        return map;
+    });
+
+    run("range constructor", [&] { return exemplar::HashMap<int, int>(entries.begin(), entries.end()); });
+
+    return 0;
+}
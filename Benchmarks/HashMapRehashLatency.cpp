@@ -0,0 +1,68 @@
+#include "HashMap.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+// Times every single insert into an exemplar::HashMap and reports the tail,
+// once per RehashPolicy. The all-at-once policy shows one spike per doubling;
+// the incremental policy spreads that work across later operations.
+//
+// Usage: HashMapRehashLatency [entry_count]
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+void report(const char* label, std::vector<double>& latencies_ns, double total_ms) {
+    std::sort(latencies_ns.begin(), latencies_ns.end());
+    const auto percentile = [&](double p) {
+        const auto index = static_cast<std::size_t>(p * static_cast<double>(latencies_ns.size() - 1));
+        return latencies_ns[index];
+    };
+
+    std::cout << label << ": total " << total_ms << " ms"
+              << ", p50 " << percentile(0.50) << " ns"
+              << ", p99 " << percentile(0.99) << " ns"
+              << ", p99.9 " << percentile(0.999) << " ns"
+              << ", max " << latencies_ns.back() / 1e6 << " ms" << std::endl;
+}
+
+void run(const char* label, exemplar::RehashPolicy policy, const std::vector<int>& keys) {
+    exemplar::HashMap<int, int> map(policy);
+    std::vector<double> latencies_ns;
+    latencies_ns.reserve(keys.size());
+
+    const auto start = Clock::now();
+    for (int key : keys) {
+        const auto before = Clock::now();
+        map.insert_or_assign(key, key);
+        const auto after = Clock::now();
+        latencies_ns.push_back(std::chrono::duration<double, std::nano>(after - before).count());
+    }
+    const double total_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    report(label, latencies_ns, total_ms);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t entry_count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2'000'000;
+
+    std::mt19937 rng(42);
+    std::vector<int> keys(entry_count);
+    for (auto& key : keys) {
+        key = static_cast<int>(rng());
+    }
+
+    std::cout << "Inserting " << entry_count << " random int keys" << std::endl;
+    run("all_at_once", exemplar::RehashPolicy::all_at_once, keys);
+    run("incremental", exemplar::RehashPolicy::incremental, keys);
+
+    return 0;
+}
@@ -0,0 +1,69 @@
+#include "HashMap.h"
+#include "HashMapSnapshot.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include <utility>
+#include <vector>
+
+// Compares "startup" by rebuilding an exemplar::HashMap from its entries
+// against opening a memory-mapped HashMapSnapshot of the same data, then
+// compares random lookup throughput of the two.
+//
+// Usage: HashMapSnapshotStartup [entry_count]
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double elapsed_ms(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t entry_count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2'000'000;
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "HashMapSnapshotStartup.snap";
+
+    std::mt19937 rng(42);
+    std::vector<std::pair<int, int>> entries(entry_count);
+    for (auto& [key, value] : entries) {
+        key = static_cast<int>(rng());
+        value = key;
+    }
+
+    const exemplar::HashMap<int, int> source(entries.begin(), entries.end());
+
+    auto start = Clock::now();
+    exemplar::HashMapSnapshot<int, int>::write(source, path.string());
+    std::cout << "write snapshot: " << elapsed_ms(start) << " ms (" << std::filesystem::file_size(path) << " bytes)" << std::endl;
+
+    start = Clock::now();
+    const exemplar::HashMap<int, int> rebuilt(entries.begin(), entries.end());
+    std::cout << "rebuild HashMap: " << elapsed_ms(start) << " ms" << std::endl;
+
+    start = Clock::now();
+    const exemplar::HashMapSnapshot<int, int> snapshot(path.string());
+    std::cout << "open snapshot: " << elapsed_ms(start) << " ms" << std::endl;
+
+    long long checksum = 0;
+    start = Clock::now();
+    for (const auto& [key, value] : entries) {
+        checksum += *rebuilt.get(key);
+    }
+    std::cout << "HashMap lookups: " << elapsed_ms(start) << " ms" << std::endl;
+
+    start = Clock::now();
+    for (const auto& [key, value] : entries) {
+        checksum -= *snapshot.get(key);
+    }
+    std::cout << "snapshot lookups: " << elapsed_ms(start) << " ms (checksum " << checksum << ")" << std::endl;
+
+    std::filesystem::remove(path);
+    return 0;
+}
@@ -0,0 +1,97 @@
+#include "MpmcQueue.h"
+#include "Queue.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Measures queue throughput as threads are added, from 1 to max_threads
+// (doubling). Every thread is both a producer and a consumer: it enqueues an
+// item and then dequeues one, so every thread count works, including one,
+// and the queue holds at most one item per thread. Compares MpmcQueue with
+// a std::mutex around exemplar::Queue.
+//
+// Usage: MpmcScaling [max_threads] [pairs]
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t k_capacity = 1024;
+
+class LockedQueue {
+public:
+    explicit LockedQueue(std::size_t /*capacity*/) {}
+
+    void enqueue(std::uint64_t value) {
+        std::lock_guard lock(mutex_);
+        queue_.enqueue(value);
+    }
+
+    // The queue holds an item for every thread that has enqueued and not
+    // yet dequeued, so this thread's own item guarantees it is never empty.
+    std::uint64_t dequeue() {
+        std::lock_guard lock(mutex_);
+        const std::uint64_t value = queue_.front();
+        queue_.dequeue();
+        return value;
+    }
+
+private:
+    std::mutex mutex_;
+    exemplar::Queue<std::uint64_t> queue_;
+};
+
+template <typename Fifo>
+double ops_per_second(std::size_t thread_count, std::size_t pairs) {
+    Fifo fifo(k_capacity);
+    const std::size_t per_thread = pairs / thread_count;
+
+    std::vector<std::uint64_t> sums(thread_count);
+    const auto start = Clock::now();
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < thread_count; ++t) {
+        threads.emplace_back([&, t] {
+            std::uint64_t sum = 0;
+            for (std::size_t i = 0; i < per_thread; ++i) {
+                fifo.enqueue(i);
+                sum += fifo.dequeue();
+            }
+            sums[t] = sum;
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::uint64_t total = 0;
+    for (std::uint64_t sum : sums) {
+        total += sum;
+    }
+    if (total != thread_count * (per_thread * (per_thread - 1) / 2)) {
+        std::cerr << "lost an item" << std::endl;
+    }
+    return static_cast<double>(2 * per_thread * thread_count) / seconds;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t max_threads = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 64;
+    const std::size_t pairs = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 4'000'000;
+
+    std::cout << "hardware threads: " << std::thread::hardware_concurrency() << std::endl;
+    std::cout << "threads, MpmcQueue ops/s, mutex Queue ops/s" << std::endl;
+    for (std::size_t threads = 1; threads <= max_threads; threads *= 2) {
+        std::cout << threads << ", " << ops_per_second<exemplar::MpmcQueue<std::uint64_t>>(threads, pairs) << ", "
+                  << ops_per_second<LockedQueue>(threads, pairs) << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,103 @@
+#include "ParallelAlgorithms.h"
+#include "ResizingArray.h"
+#include "ThreadPool.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+// Runs parallel_transform, parallel_reduce, parallel_inclusive_scan and
+// parallel_sort over a ResizingArray<float> with pools of 1, 2, 4, ... up to
+// all hardware threads, and prints each time with its speedup over one
+// thread.
+//
+// The default size fits in a few GB; pass 1000000000 on a machine with
+// 16 GB or more for the full-size run (sort needs a second buffer).
+//
+// Usage: ParallelAlgorithmsScaling [element_count]
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+template <typename Fn>
+double time_ms(Fn&& fn) {
+    const auto start = Clock::now();
+    fn();
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// Cheap deterministic pseudo-random floats in [0, 1).
+float noise(std::size_t i) {
+    std::uint64_t x = (i + 1) * 0x9E3779B97F4A7C15ULL;
+    x ^= x >> 29;
+    x *= 0xBF58476D1CE4E5B9ULL;
+    x ^= x >> 32;
+    return static_cast<float>(x >> 40) / static_cast<float>(1 << 24);
+}
+
+struct Timings {
+    double transform_ms;
+    double reduce_ms;
+    double scan_ms;
+    double sort_ms;
+};
+
+Timings run(std::size_t thread_count, const exemplar::ResizingArray<float>& input,
+            exemplar::ResizingArray<float>& work, double& checksum) {
+    exemplar::ThreadPool pool(thread_count);
+    Timings timings{};
+
+    timings.transform_ms = time_ms([&] {
+        exemplar::parallel_transform(input, work, [](float x) { return x * 2.0f + 1.0f; }, pool);
+    });
+    timings.reduce_ms = time_ms([&] { checksum += exemplar::parallel_reduce(work, 0.0f, std::plus<>{}, pool); });
+    timings.scan_ms = time_ms([&] { exemplar::parallel_inclusive_scan(input, work, std::plus<>{}, pool); });
+
+    exemplar::parallel_transform(input, work, [](float x) { return x; }, pool);
+    timings.sort_ms = time_ms([&] { exemplar::parallel_sort(work, std::less<>{}, pool); });
+    checksum += work[work.size() / 2];
+    return timings;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200'000'000;
+    const std::size_t max_threads = std::max(1u, std::thread::hardware_concurrency());
+
+    exemplar::ResizingArray<float> input;
+    input.resize_uninitialized(count);
+    exemplar::parallel_for(count, [&](std::size_t i) { input[i] = noise(i); });
+    exemplar::ResizingArray<float> work;
+    work.resize_uninitialized(count);
+
+    std::vector<std::size_t> thread_counts;
+    for (std::size_t threads = 1; threads < max_threads; threads *= 2) {
+        thread_counts.push_back(threads);
+    }
+    thread_counts.push_back(max_threads);
+
+    std::cout << "elements: " << count << ", hardware threads: " << max_threads << std::endl;
+    double checksum = 0.0;
+    Timings baseline{};
+    for (std::size_t threads : thread_counts) {
+        const Timings t = run(threads, input, work, checksum);
+        if (threads == 1) {
+            baseline = t;
+        }
+        std::cout << threads << " threads: transform " << t.transform_ms << " ms (x"
+                  << baseline.transform_ms / t.transform_ms << "), reduce " << t.reduce_ms << " ms (x"
+                  << baseline.reduce_ms / t.reduce_ms << "), scan " << t.scan_ms << " ms (x"
+                  << baseline.scan_ms / t.scan_ms << "), sort " << t.sort_ms << " ms (x" << baseline.sort_ms / t.sort_ms
+                  << ")" << std::endl;
+    }
+    std::cout << "[" << checksum << "]" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,147 @@
+#include "BinarySearchTree.h"
+#include "DoublyLinkedList.h"
+#include "HashMap.h"
+#include "Heap.h"
+#include "Queue.h"
+#include "ResizingArray.h"
+#include "SinglyLinkedList.h"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <memory_resource>
+
+// Simulates request handling: each request builds a handful of small,
+// short-lived containers (an array, a hash map, a queue, a heap, a tree and
+// two lists), uses them and throws them away. Compares:
+//   - the default std::allocator containers,
+//   - the pmr containers on the global heap (one heap call per allocation),
+//   - the pmr containers on a per-request monotonic_buffer_resource backed
+//     by a stack buffer, released at the end of each request.
+// Heap calls are counted by a memory_resource that wraps new_delete_resource.
+//
+// Usage: PmrRequestArena [requests] [items_per_request]
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Forwards to another resource and counts the allocations that reach it.
+class CountingResource : public std::pmr::memory_resource {
+public:
+    explicit CountingResource(std::pmr::memory_resource* upstream) : upstream_(upstream) {}
+
+    [[nodiscard]] std::size_t allocations() const noexcept { return allocations_; }
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        ++allocations_;
+        return upstream_->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+        upstream_->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    std::pmr::memory_resource* upstream_;
+    std::size_t allocations_{0};
+};
+
+// The containers one request uses. Allocator-aware containers are built
+// from make(), which is either a std::pmr::memory_resource* or nothing.
+template <template <typename...> typename Array, template <typename...> typename Map,
+          template <typename...> typename Fifo, template <typename...> typename PriorityQueue,
+          template <typename...> typename Tree, template <typename...> typename Forward,
+          template <typename...> typename List, typename... Resource>
+std::size_t handle_request(std::size_t items, Resource... resource) {
+    Array<int> ids(resource...);
+    Map<int, int> counts(resource...);
+    Fifo<int> pending(resource...);
+    PriorityQueue<int> by_priority(resource...);
+    Tree<int> seen(resource...);
+    Forward<int> log(resource...);
+    List<int> history(resource...);
+
+    for (std::size_t i = 0; i < items; ++i) {
+        const int value = static_cast<int>((i * 7919) % 1024);
+        ids.push_back(value);
+        counts[value % 64] += 1;
+        pending.enqueue(value);
+        by_priority.push(value);
+        seen.insert(value);
+        log.push_front(value);
+        history.push_back(value);
+    }
+
+    std::size_t checksum = ids.size() + counts.size() + seen.size() + log.size() + history.size();
+    while (!pending.empty()) {
+        checksum += static_cast<std::size_t>(pending.front());
+        pending.dequeue();
+    }
+    checksum += static_cast<std::size_t>(by_priority.top());
+    return checksum;
+}
+
+template <typename Request>
+void run(const char* label, std::size_t requests, Request&& request, const CountingResource* counter) {
+    std::size_t checksum = 0;
+    const auto start = Clock::now();
+    for (std::size_t r = 0; r < requests; ++r) {
+        checksum += request();
+    }
+    const double elapsed_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    std::cout << label << ": " << elapsed_ms * 1e6 / static_cast<double>(requests) << " ns/request";
+    if (counter != nullptr) {
+        std::cout << ", " << static_cast<double>(counter->allocations()) / static_cast<double>(requests)
+                  << " heap allocations/request";
+    }
+    std::cout << " [" << checksum << "]" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    using namespace exemplar;
+
+    const std::size_t requests = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100'000;
+    const std::size_t items = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 32;
+
+    run("std::allocator", requests,
+        [&] {
+            return handle_request<ResizingArray, HashMap, Queue, Heap, BinarySearchTree, SinglyLinkedList,
+                                  DoublyLinkedList>(items);
+        },
+        nullptr);
+
+    CountingResource heap(std::pmr::new_delete_resource());
+    run("pmr, new_delete_resource", requests,
+        [&] {
+            std::pmr::memory_resource* resource = &heap;
+            return handle_request<pmr::ResizingArray, pmr::HashMap, pmr::Queue, pmr::Heap, pmr::BinarySearchTree,
+                                  pmr::SinglyLinkedList, pmr::DoublyLinkedList>(items, resource);
+        },
+        &heap);
+
+    // Sized for the default workload; larger requests spill to the heap,
+    // which the allocation count shows.
+    alignas(std::max_align_t) static std::array<std::byte, 64 * 1024> buffer;
+    CountingResource upstream(std::pmr::new_delete_resource());
+    std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(), &upstream);
+    run("pmr, per-request monotonic arena", requests,
+        [&] {
+            std::pmr::memory_resource* resource = &arena;
+            const std::size_t checksum =
+                handle_request<pmr::ResizingArray, pmr::HashMap, pmr::Queue, pmr::Heap, pmr::BinarySearchTree,
+                               pmr::SinglyLinkedList, pmr::DoublyLinkedList>(items, resource);
+            arena.release();
+            return checksum;
+        },
+        &upstream);
+
+    return 0;
+}
@@ -0,0 +1,134 @@
+#include "Queue.h"
+#include "RingQueue.h"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <span>
+
+// Streams messages through a queue that holds `depth` of them in steady
+// state, the way a message pump does: producers enqueue a burst, consumers
+// drain a burst. Compares the linked Queue (a node new/delete per message)
+// with RingQueue one message at a time and with enqueue_range /
+// dequeue_into, and with std::deque.
+//
+// Usage: QueueThroughput [messages] [depth] [burst]
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t k_max_burst = 256;
+
+// Keeps the dequeued ids observable so the loops are not optimized away.
+volatile std::uint64_t g_sink = 0;
+
+struct Message {
+    std::uint64_t id;
+    std::uint32_t topic;
+    std::uint32_t length;
+};
+
+struct Config {
+    std::size_t messages;
+    std::size_t depth;
+    std::size_t burst;
+};
+
+template <typename Push, typename Pop>
+double ns_per_message(const Config& config, Push push, Pop pop) {
+    for (std::size_t i = 0; i < config.depth; ++i) {
+        push(i, 1);
+    }
+
+    std::uint64_t checksum = 0;
+    const auto start = Clock::now();
+    for (std::size_t sent = 0; sent < config.messages; sent += config.burst) {
+        push(sent, config.burst);
+        checksum += pop(config.burst);
+    }
+    const double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+    g_sink = g_sink + checksum;
+    return ns / static_cast<double>(config.messages);
+}
+
+Message make_message(std::size_t i) {
+    return Message{i, static_cast<std::uint32_t>(i % 64), static_cast<std::uint32_t>(i % 1500)};
+}
+
+template <typename Fifo>
+double one_at_a_time(const Config& config) {
+    Fifo fifo;
+    auto push = [&](std::size_t first, std::size_t count) {
+        for (std::size_t i = 0; i < count; ++i) {
+            if constexpr (requires { fifo.enqueue(make_message(first)); }) {
+                fifo.enqueue(make_message(first + i));
+            } else {
+                fifo.push_back(make_message(first + i));
+            }
+        }
+    };
+    auto pop = [&](std::size_t count) {
+        std::uint64_t sum = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            sum += fifo.front().id;
+            if constexpr (requires { fifo.dequeue(); }) {
+                fifo.dequeue();
+            } else {
+                fifo.pop_front();
+            }
+        }
+        return sum;
+    };
+    return ns_per_message(config, push, pop);
+}
+
+double ring_bulk(const Config& config) {
+    exemplar::RingQueue<Message> fifo;
+    std::array<Message, k_max_burst> batch{};
+    auto push = [&](std::size_t first, std::size_t count) {
+        for (std::size_t i = 0; i < count; ++i) {
+            batch[i] = make_message(first + i);
+        }
+        fifo.enqueue_range(std::span<const Message>(batch.data(), count));
+    };
+    auto pop = [&](std::size_t count) {
+        const std::size_t taken = fifo.dequeue_into(batch.data(), count);
+        std::uint64_t sum = 0;
+        for (std::size_t i = 0; i < taken; ++i) {
+            sum += batch[i].id;
+        }
+        return sum;
+    };
+    return ns_per_message(config, push, pop);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Config config{};
+    config.messages = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 20'000'000;
+    config.depth = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1000;
+    config.burst = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 32;
+    if (config.burst == 0 || config.burst > k_max_burst) {
+        std::cerr << "burst must be between 1 and " << k_max_burst << std::endl;
+        return 1;
+    }
+
+    std::cout << "messages: " << config.messages << ", depth: " << config.depth << ", burst: " << config.burst
+              << std::endl;
+    std::cout << "Queue (linked):            " << one_at_a_time<exemplar::Queue<Message>>(config) << " ns/message"
+              << std::endl;
+    std::cout << "RingQueue:                 " << one_at_a_time<exemplar::RingQueue<Message>>(config)
+              << " ns/message" << std::endl;
+    std::cout << "RingQueue (bulk):          " << ring_bulk(config) << " ns/message" << std::endl;
+    std::cout << "std::deque:                " << one_at_a_time<std::deque<Message>>(config) << " ns/message"
+              << std::endl;
+
+    return 0;
+}
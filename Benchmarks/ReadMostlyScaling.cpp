@@ -0,0 +1,109 @@
+#include "HashMap.h"
+#include "ReadMostlyHashMap.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+// Measures lookup throughput as reader threads are added while one writer
+// keeps updating the table in the background. Compares ReadMostlyHashMap
+// (lock-free readers, epoch reclamation) with a HashMap behind a
+// std::shared_mutex.
+//
+// Usage: ReadMostlyScaling [max_threads] [milliseconds_per_run]
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int k_key_count = 10'000;
+constexpr auto k_write_interval = std::chrono::milliseconds(1);
+
+class SharedMutexMap {
+public:
+    std::optional<int> get(int key) const {
+        std::shared_lock lock(mutex_);
+        return map_.get(key);
+    }
+
+    bool insert_or_assign(int key, int value) {
+        std::unique_lock lock(mutex_);
+        return map_.insert_or_assign(key, value);
+    }
+
+private:
+    mutable std::shared_mutex mutex_;
+    exemplar::HashMap<int, int> map_;
+};
+
+template <typename Map>
+double reads_per_second(Map& map, std::size_t reader_count, std::chrono::milliseconds duration) {
+    std::atomic<bool> stop{false};
+    std::atomic<long long> total_reads{0};
+
+    std::thread writer([&] {
+        int round = 0;
+        while (!stop.load(std::memory_order_relaxed)) {
+            map.insert_or_assign(round % k_key_count, round);
+            ++round;
+            std::this_thread::sleep_for(k_write_interval);
+        }
+    });
+
+    std::vector<std::thread> readers;
+    for (std::size_t t = 0; t < reader_count; ++t) {
+        readers.emplace_back([&, t] {
+            long long reads = 0;
+            int key = static_cast<int>(t);
+            while (!stop.load(std::memory_order_relaxed)) {
+                if (map.get(key)) {
+                    ++reads;
+                }
+                key = (key + 7919) % k_key_count;
+            }
+            total_reads += reads;
+        });
+    }
+
+    std::this_thread::sleep_for(duration);
+    stop = true;
+    writer.join();
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    return static_cast<double>(total_reads.load()) / std::chrono::duration<double>(duration).count();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t hardware = std::thread::hardware_concurrency() == 0 ? 1 : std::thread::hardware_concurrency();
+    const std::size_t max_threads = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : hardware;
+    const auto duration = std::chrono::milliseconds(argc > 2 ? std::strtoll(argv[2], nullptr, 10) : 500);
+
+    exemplar::ReadMostlyHashMap<int, int> read_mostly;
+    SharedMutexMap locked;
+    read_mostly.update([](auto& map) {
+        for (int key = 0; key < k_key_count; ++key) {
+            map.insert_or_assign(key, key);
+        }
+    });
+    for (int key = 0; key < k_key_count; ++key) {
+        locked.insert_or_assign(key, key);
+    }
+
+    std::cout << "readers, ReadMostlyHashMap reads/s, shared_mutex HashMap reads/s" << std::endl;
+    for (std::size_t threads = 1; threads <= max_threads; threads *= 2) {
+        std::cout << threads << ", " << reads_per_second(read_mostly, threads, duration) << ", "
+                  << reads_per_second(locked, threads, duration) << std::endl;
+    }
+
+    return 0;
+}
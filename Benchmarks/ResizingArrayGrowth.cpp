@@ -0,0 +1,98 @@
+#include "ResizingArray.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Measures filling a ResizingArray from empty, against std::vector:
+// push_back of ints (realloc growth), push_back of strings (move-only
+// relocation into uninitialized storage), and a bulk fill through
+// resize_uninitialized() + data(). Int throughput is reported in GB/s of
+// element data written, to compare with memory bandwidth.
+//
+// Usage: ResizingArrayGrowth [int_count] [string_count]
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+template <typename Fill>
+void run(const char* label, std::size_t bytes, Fill&& fill) {
+    const auto start = Clock::now();
+    const std::size_t checksum = fill();
+    const double elapsed_s = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::cout << label << ": " << elapsed_s * 1000 << " ms";
+    if (bytes != 0) {
+        std::cout << " (" << static_cast<double>(bytes) / elapsed_s / 1e9 << " GB/s)";
+    }
+    std::cout << " [" << checksum << "]" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t int_count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100'000'000;
+    const std::size_t string_count = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 4'000'000;
+    const std::size_t int_bytes = int_count * sizeof(int);
+
+    run("ResizingArray<int> push_back", int_bytes, [&] {
+        exemplar::ResizingArray<int> array;
+        for (std::size_t i = 0; i < int_count; ++i) {
+            array.push_back(static_cast<int>(i));
+        }
+        return static_cast<std::size_t>(array.back());
+    });
+
+    run("std::vector<int> push_back", int_bytes, [&] {
+        std::vector<int> vector;
+        for (std::size_t i = 0; i < int_count; ++i) {
+            vector.push_back(static_cast<int>(i));
+        }
+        return static_cast<std::size_t>(vector.back());
+    });
+
+    run("ResizingArray<int> resize_uninitialized + fill", int_bytes, [&] {
+        exemplar::ResizingArray<int> array;
+        array.resize_uninitialized(int_count);
+        int* data = array.data();
+        for (std::size_t i = 0; i < int_count; ++i) {
+            data[i] = static_cast<int>(i);
+        }
+        return static_cast<std::size_t>(array.back());
+    });
+
+    run("std::vector<int> resize + fill", int_bytes, [&] {
+        std::vector<int> vector;
+        vector.resize(int_count);
+        for (std::size_t i = 0; i < int_count; ++i) {
+            vector[i] = static_cast<int>(i);
+        }
+        return static_cast<std::size_t>(vector.back());
+    });
+
+    // Long enough to defeat the small-string buffer, so every element owns
+    // a heap allocation and a copy during growth would be visible.
+    const std::string prefix(32, 'x');
+
+    run("ResizingArray<std::string> push_back", 0, [&] {
+        exemplar::ResizingArray<std::string> array;
+        for (std::size_t i = 0; i < string_count; ++i) {
+            array.push_back(prefix + std::to_string(i));
+        }
+        return array.back().size();
+    });
+
+    run("std::vector<std::string> push_back", 0, [&] {
+        std::vector<std::string> vector;
+        for (std::size_t i = 0; i < string_count; ++i) {
+            vector.push_back(prefix + std::to_string(i));
+        }
+        return vector.back().size();
+    });
+
+    return 0;
+}
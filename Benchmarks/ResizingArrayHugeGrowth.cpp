@@ -0,0 +1,76 @@
+#include "ResizingArray.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Grows a ResizingArray<double> one push_back at a time to a multi-GB size,
+// against std::vector<double>, then sums it. Past
+// ResizingArray::k_page_mapping_threshold_bytes the array grows with mremap,
+// so doubling does not copy, and its pages can be transparent huge pages.
+// For each run it prints the growth time, the scan time, the peak resident
+// memory and how much of the array sits in huge pages (Linux /proc).
+//
+// Usage: ResizingArrayHugeGrowth [element_count]
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Reads a "Name:   1234 kB" line from a /proc status-style file, in MB.
+double proc_megabytes(const char* path, const std::string& name) {
+    std::ifstream file(path);
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.starts_with(name + ":")) {
+            return std::strtod(line.c_str() + name.size() + 1, nullptr) / 1024.0;
+        }
+    }
+    return 0.0;
+}
+
+// Resets VmHWM (peak resident memory) so each run reports its own peak.
+void reset_peak_rss() {
+    std::ofstream("/proc/self/clear_refs") << "5";
+}
+
+template <typename Array>
+void run(const char* label, std::size_t count) {
+    reset_peak_rss();
+
+    Array array;
+    const auto grow_start = Clock::now();
+    for (std::size_t i = 0; i < count; ++i) {
+        array.push_back(static_cast<double>(i));
+    }
+    const double grow_ms = std::chrono::duration<double, std::milli>(Clock::now() - grow_start).count();
+
+    const auto scan_start = Clock::now();
+    double sum = 0.0;
+    const double* data = array.data();
+    for (std::size_t i = 0; i < count; ++i) {
+        sum += data[i];
+    }
+    const double scan_ms = std::chrono::duration<double, std::milli>(Clock::now() - scan_start).count();
+
+    std::cout << label << ": grow " << grow_ms << " ms, scan " << scan_ms << " ms, peak RSS "
+              << proc_megabytes("/proc/self/status", "VmHWM") << " MB, huge pages "
+              << proc_megabytes("/proc/self/smaps_rollup", "AnonHugePages") << " MB [" << sum << "]" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200'000'000;
+
+    std::cout << "elements: " << count << " (" << static_cast<double>(count * sizeof(double)) / (1 << 20)
+              << " MB)" << std::endl;
+    run<exemplar::ResizingArray<double>>("ResizingArray<double>", count);
+    run<std::vector<double>>("std::vector<double>", count);
+
+    return 0;
+}
@@ -0,0 +1,92 @@
+#include "ResizingArray.h"
+#include "SegmentedArray.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <string>
+#include <type_traits>
+
+// Appends n elements one push_back at a time, then reads them back by index
+// and by iteration, with ResizingArray, SegmentedArray and std::deque.
+// ResizingArray moves every element on each growth; SegmentedArray only
+// allocates a new block. std::string elements make the moves visible.
+//
+// Usage: SegmentedArrayGrowth [element_count]
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double elapsed_ms(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+template <typename T>
+T make_element(std::size_t i) {
+    if constexpr (std::is_same_v<T, std::string>) {
+        return "registry-entry-" + std::to_string(i);
+    } else {
+        return T(i);
+    }
+}
+
+template <typename T>
+std::size_t weight(const T& value) {
+    if constexpr (std::is_same_v<T, std::string>) {
+        return value.size();
+    } else {
+        return static_cast<std::size_t>(value);
+    }
+}
+
+template <typename Array, typename T>
+void run(const char* label, std::size_t count) {
+    auto start = Clock::now();
+    Array array;
+    for (std::size_t i = 0; i < count; ++i) {
+        array.push_back(make_element<T>(i));
+    }
+    const double append_ms = elapsed_ms(start);
+
+    std::size_t checksum = 0;
+    start = Clock::now();
+    for (std::size_t i = 0; i < count; ++i) {
+        checksum += weight(array[i]);
+    }
+    const double index_ms = elapsed_ms(start);
+
+    start = Clock::now();
+    if constexpr (std::is_same_v<Array, exemplar::ResizingArray<T>>) {
+        // ResizingArray has no iterators; walk its contiguous storage.
+        for (const T* element = array.data(); element != array.data() + array.size(); ++element) {
+            checksum += weight(*element);
+        }
+    } else {
+        for (const T& element : array) {
+            checksum += weight(element);
+        }
+    }
+    const double iterate_ms = elapsed_ms(start);
+
+    std::cout << label << ": append " << append_ms << " ms, index " << index_ms << " ms, iterate " << iterate_ms
+              << " ms [" << checksum << "]" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000'000;
+
+    run<exemplar::ResizingArray<std::size_t>, std::size_t>("ResizingArray<size_t>", count);
+    run<exemplar::SegmentedArray<std::size_t>, std::size_t>("SegmentedArray<size_t>", count);
+    run<std::deque<std::size_t>, std::size_t>("std::deque<size_t>", count);
+
+    run<exemplar::ResizingArray<std::string>, std::string>("ResizingArray<std::string>", count);
+    run<exemplar::SegmentedArray<std::string>, std::string>("SegmentedArray<std::string>", count);
+    run<std::deque<std::string>, std::string>("std::deque<std::string>", count);
+
+    return 0;
+}
@@ -0,0 +1,94 @@
+#include "ResizingArray.h"
+#include "SimdKernels.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+// Times find, count, min_max, sum and dot over collections::ResizingArray
+// of int, float, double and char, at every SIMD level this CPU supports,
+// and prints each as ns per element with the speedup over the scalar
+// kernel. The array is scanned repeatedly, so it should fit in cache for
+// compute-bound numbers (the default does) or exceed it to see memory
+// bandwidth limits.
+//
+// Usage: SimdKernelsScan [element_count]
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using namespace collections;
+
+// Elements processed per measurement, across repetitions.
+constexpr std::size_t k_elements_per_run = 400'000'000;
+
+template <typename T>
+ResizingArray<T> make_array(std::size_t count, std::size_t seed) {
+    ResizingArray<T> array(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        array.push_back(static_cast<T>((i * 2654435761u + seed) % 101));
+    }
+    return array;
+}
+
+template <typename Fn>
+double ns_per_element(std::size_t count, Fn&& fn) {
+    const std::size_t repetitions = k_elements_per_run / count + 1;
+    double sink = 0.0;
+    const auto start = Clock::now();
+    for (std::size_t r = 0; r < repetitions; ++r) {
+        sink += static_cast<double>(fn());
+    }
+    const double elapsed_ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    if (sink == -1.0) {
+        std::cout << "";
+    }
+    return elapsed_ns / static_cast<double>(repetitions * count);
+}
+
+template <typename T>
+void run(const char* type_name, std::size_t count) {
+    const ResizingArray<T> left = make_array<T>(count, 7);
+    const ResizingArray<T> right = make_array<T>(count, 13);
+    // 101 never occurs, so find scans the whole array.
+    const T missing = static_cast<T>(101);
+
+    double scalar[5] = {};
+    for (int level = 0; level <= static_cast<int>(simd::detected_level()); ++level) {
+        simd::set_level(static_cast<simd::SimdLevel>(level));
+        const double results[5] = {
+            ns_per_element(count, [&] { return simd::find(left, missing); }),
+            ns_per_element(count, [&] { return simd::count(left, static_cast<T>(42)); }),
+            ns_per_element(count, [&] { return simd::min_max(left).max; }),
+            ns_per_element(count, [&] { return simd::sum(left); }),
+            ns_per_element(count, [&] { return simd::dot(left, right); }),
+        };
+        if (level == 0) {
+            std::copy(results, results + 5, scalar);
+        }
+
+        const char* names[5] = {"find", "count", "min_max", "sum", "dot"};
+        std::cout << type_name << " " << simd::level_name(static_cast<simd::SimdLevel>(level)) << ":";
+        for (int k = 0; k < 5; ++k) {
+            std::cout << " " << names[k] << " " << results[k] << " ns (x" << scalar[k] / results[k] << ")";
+        }
+        std::cout << std::endl;
+    }
+    simd::set_level(simd::detected_level());
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 16 * 1024;
+
+    std::cout << "elements: " << count << ", detected: " << simd::level_name(simd::detected_level()) << std::endl;
+    run<int>("int", count);
+    run<float>("float", count);
+    run<double>("double", count);
+    run<char>("char", count);
+
+    return 0;
+}
@@ -0,0 +1,71 @@
+#include "ResizingArray.h"
+#include "SmallResizingArray.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Creates, fills and destroys many short-lived arrays of 0-8 elements, as
+// request objects do, with ResizingArray, SmallResizingArray<T, 8> and
+// std::vector. Arrays that fit inline never call the allocator.
+//
+// Usage: SmallResizingArrayChurn [array_count]
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+template <typename T>
+T make_element(unsigned char i) {
+    if constexpr (std::is_same_v<T, std::string>) {
+        return std::to_string(i);
+    } else {
+        return T(i);
+    }
+}
+
+template <typename Array, typename T>
+void run(const char* label, const std::vector<unsigned char>& lengths) {
+    std::size_t checksum = 0;
+    const auto start = Clock::now();
+    for (unsigned char length : lengths) {
+        Array array;
+        for (unsigned char i = 0; i < length; ++i) {
+            array.push_back(make_element<T>(i));
+        }
+        checksum += array.size();
+    }
+    const double elapsed_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    std::cout << label << ": " << elapsed_ms << " ms"
+              << " (" << elapsed_ms * 1e6 / static_cast<double>(lengths.size()) << " ns/array) [" << checksum << "]"
+              << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t array_count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000'000;
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> length(0, 8);
+    std::vector<unsigned char> lengths(array_count);
+    for (auto& value : lengths) {
+        value = static_cast<unsigned char>(length(rng));
+    }
+
+    run<exemplar::ResizingArray<int>, int>("ResizingArray<int>", lengths);
+    run<exemplar::SmallResizingArray<int, 8>, int>("SmallResizingArray<int, 8>", lengths);
+    run<std::vector<int>, int>("std::vector<int>", lengths);
+
+    run<exemplar::ResizingArray<std::string>, std::string>("ResizingArray<std::string>", lengths);
+    run<exemplar::SmallResizingArray<std::string, 8>, std::string>("SmallResizingArray<std::string, 8>", lengths);
+    run<std::vector<std::string>, std::string>("std::vector<std::string>", lengths);
+
+    return 0;
+}
@@ -0,0 +1,201 @@
+#include "Queue.h"
+#include "SpscQueue.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+// Two measurements between one producer and one consumer thread, for
+// SpscQueue and for a std::mutex around exemplar::Queue:
+//
+//   ping-pong: a value bounces back and forth through two queues, so every
+//   hop waits for the previous one; reports the one-way handoff latency.
+//   streaming: the producer pushes as fast as the consumer keeps up;
+//   reports ops/s, for SpscQueue one at a time and in batches.
+//
+// Waiting threads spin briefly and then yield, so the benchmark also makes
+// progress when both threads share one core (where latency then measures
+// the scheduler rather than the queue).
+//
+// Usage: SpscPingPong [round_trips] [streamed_items]
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t k_capacity = 1024;
+constexpr std::size_t k_batch = 64;
+
+// Spins for a while, then starts yielding the core.
+class Backoff {
+public:
+    void pause() {
+        if (++spins_ > k_spin_limit) {
+            std::this_thread::yield();
+        }
+    }
+
+    void reset() noexcept { spins_ = 0; }
+
+private:
+    static constexpr int k_spin_limit = 256;
+    int spins_{0};
+};
+
+// The same try_push / try_pop surface over a mutex-guarded linked Queue.
+class LockedQueue {
+public:
+    explicit LockedQueue(std::size_t /*capacity*/) {}
+
+    bool try_push(std::uint64_t value) {
+        std::lock_guard lock(mutex_);
+        queue_.enqueue(value);
+        return true;
+    }
+
+    bool try_pop(std::uint64_t& out) {
+        std::lock_guard lock(mutex_);
+        if (queue_.empty()) {
+            return false;
+        }
+        out = queue_.front();
+        queue_.dequeue();
+        return true;
+    }
+
+private:
+    std::mutex mutex_;
+    exemplar::Queue<std::uint64_t> queue_;
+};
+
+template <typename Fifo>
+void push(Fifo& fifo, std::uint64_t value) {
+    Backoff backoff;
+    while (!fifo.try_push(value)) {
+        backoff.pause();
+    }
+}
+
+template <typename Fifo>
+std::uint64_t pop(Fifo& fifo) {
+    Backoff backoff;
+    std::uint64_t value = 0;
+    while (!fifo.try_pop(value)) {
+        backoff.pause();
+    }
+    return value;
+}
+
+template <typename Fifo>
+double ns_per_hop(std::size_t round_trips) {
+    Fifo ping(k_capacity);
+    Fifo pong(k_capacity);
+
+    std::thread echo([&] {
+        for (std::size_t i = 0; i < round_trips; ++i) {
+            push(pong, pop(ping) + 1);
+        }
+    });
+
+    const auto start = Clock::now();
+    std::uint64_t value = 0;
+    for (std::size_t i = 0; i < round_trips; ++i) {
+        push(ping, value);
+        value = pop(pong);
+    }
+    const double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    echo.join();
+
+    if (value != round_trips) {
+        std::cerr << "ping-pong lost a value" << std::endl;
+    }
+    return ns / static_cast<double>(2 * round_trips);
+}
+
+template <typename Fifo, bool Bulk>
+double ops_per_second(std::size_t items) {
+    Fifo fifo(k_capacity);
+
+    const auto start = Clock::now();
+    std::thread producer([&] {
+        if constexpr (Bulk) {
+            std::array<std::uint64_t, k_batch> batch{};
+            Backoff backoff;
+            for (std::size_t sent = 0; sent < items;) {
+                const std::size_t wanted = std::min(k_batch, items - sent);
+                for (std::size_t i = 0; i < wanted; ++i) {
+                    batch[i] = sent + i;
+                }
+                std::size_t pushed = 0;
+                while (pushed < wanted) {
+                    const std::size_t accepted = fifo.try_push_bulk(batch.data() + pushed, wanted - pushed);
+                    pushed += accepted;
+                    if (accepted == 0) {
+                        backoff.pause();
+                    } else {
+                        backoff.reset();
+                    }
+                }
+                sent += wanted;
+            }
+        } else {
+            for (std::size_t i = 0; i < items; ++i) {
+                push(fifo, i);
+            }
+        }
+    });
+
+    std::uint64_t sum = 0;
+    if constexpr (Bulk) {
+        std::array<std::uint64_t, k_batch> batch{};
+        Backoff backoff;
+        for (std::size_t received = 0; received < items;) {
+            const std::size_t taken = fifo.try_pop_bulk(batch.data(), k_batch);
+            for (std::size_t i = 0; i < taken; ++i) {
+                sum += batch[i];
+            }
+            received += taken;
+            if (taken == 0) {
+                backoff.pause();
+            } else {
+                backoff.reset();
+            }
+        }
+    } else {
+        for (std::size_t i = 0; i < items; ++i) {
+            sum += pop(fifo);
+        }
+    }
+    producer.join();
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    if (sum != items * (items - 1) / 2) {
+        std::cerr << "streaming lost a value" << std::endl;
+    }
+    return static_cast<double>(items) / seconds;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t round_trips = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200'000;
+    const std::size_t items = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 20'000'000;
+
+    using Spsc = exemplar::SpscQueue<std::uint64_t>;
+    std::cout << "hardware threads: " << std::thread::hardware_concurrency() << std::endl;
+    std::cout << "ping-pong, SpscQueue:            " << ns_per_hop<Spsc>(round_trips) << " ns/hop" << std::endl;
+    std::cout << "ping-pong, mutex Queue:          " << ns_per_hop<LockedQueue>(round_trips) << " ns/hop" << std::endl;
+    std::cout << "streaming, SpscQueue:            " << ops_per_second<Spsc, false>(items) << " ops/s" << std::endl;
+    std::cout << "streaming, SpscQueue (batch " << k_batch << "): " << ops_per_second<Spsc, true>(items) << " ops/s"
+              << std::endl;
+    std::cout << "streaming, mutex Queue:          " << ops_per_second<LockedQueue, false>(items) << " ops/s"
+              << std::endl;
+
+    return 0;
+}
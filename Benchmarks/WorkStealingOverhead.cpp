@@ -0,0 +1,128 @@
+#include "ParallelAlgorithms.h"
+#include "ThreadPool.h"
+#include "WorkStealingPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <future>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+// Measures what one task costs on WorkStealingPool, with bodies that do
+// next to nothing, so the time is all scheduling:
+//   - spawn from a worker: a task spawns task_count children into a
+//     TaskGroup (its own deque) and waits;
+//   - spawn from outside: the main thread does the same through the
+//     pool's shared queue;
+//   - fork/join tree: a recursive fib whose every call spawns one child;
+//   - submit: task_count submit() calls, then every future's get();
+//   - parallel_for with grain 1, next to ThreadPool::run (one indexed
+//     task per index) and the chunked exemplar::parallel_for.
+// Prints nanoseconds per task.
+//
+// Usage: WorkStealingOverhead [task_count] [thread_count]
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+volatile std::uint64_t g_sink = 0;
+
+template <typename Fn>
+double ns_per_task(std::size_t tasks, Fn&& fn) {
+    const auto start = Clock::now();
+    fn();
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / static_cast<double>(tasks);
+}
+
+void spawn_flat(exemplar::WorkStealingPool& pool, std::size_t count, std::atomic<std::uint64_t>& done) {
+    exemplar::TaskGroup group(pool);
+    for (std::size_t i = 0; i < count; ++i) {
+        group.spawn([&done] { done.fetch_add(1, std::memory_order_relaxed); });
+    }
+    group.wait();
+}
+
+std::uint64_t fib(exemplar::WorkStealingPool& pool, unsigned n) {
+    if (n < 2) {
+        return n;
+    }
+    std::uint64_t left = 0;
+    exemplar::TaskGroup group(pool);
+    group.spawn([&] { left = fib(pool, n - 1); });
+    const std::uint64_t right = fib(pool, n - 2);
+    group.wait();
+    return left + right;
+}
+
+// Calls made by fib(n), each of which but the leaves spawns one task.
+std::uint64_t fib_spawns(unsigned n) {
+    std::uint64_t a = 0;
+    std::uint64_t b = 1;
+    for (unsigned i = 0; i < n; ++i) {
+        const std::uint64_t next = a + b;
+        a = b;
+        b = next;
+    }
+    // fib(n) makes 2 * fib(n + 1) - 1 calls; fib(n + 1) - 1 of them spawn.
+    return b - 1;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t tasks = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+    const std::size_t threads =
+        argc > 2 ? std::strtoull(argv[2], nullptr, 10) : std::max(1u, std::thread::hardware_concurrency());
+
+    exemplar::WorkStealingPool pool(threads);
+    std::cout << "tasks: " << tasks << ", threads: " << threads << std::endl;
+
+    std::atomic<std::uint64_t> done{0};
+    const double inside_ns =
+        ns_per_task(tasks, [&] { pool.submit([&] { spawn_flat(pool, tasks, done); }).get(); });
+    const double outside_ns = ns_per_task(tasks, [&] { spawn_flat(pool, tasks, done); });
+    std::cout << "spawn from a worker:  " << inside_ns << " ns/task" << std::endl;
+    std::cout << "spawn from outside:   " << outside_ns << " ns/task" << std::endl;
+
+    unsigned depth = 2;
+    while (fib_spawns(depth + 1) <= tasks) {
+        ++depth;
+    }
+    std::uint64_t result = 0;
+    const double fib_ns = ns_per_task(fib_spawns(depth), [&] { result = pool.submit([&] { return fib(pool, depth); }).get(); });
+    g_sink = result;
+    std::cout << "fork/join fib(" << depth << "): " << fib_ns << " ns/task" << std::endl;
+
+    const double submit_ns = ns_per_task(tasks, [&] {
+        std::vector<std::future<void>> futures;
+        futures.reserve(tasks);
+        for (std::size_t i = 0; i < tasks; ++i) {
+            futures.push_back(pool.submit([&done] { done.fetch_add(1, std::memory_order_relaxed); }));
+        }
+        for (auto& future : futures) {
+            future.get();
+        }
+    });
+    std::cout << "submit + future:      " << submit_ns << " ns/task" << std::endl;
+
+    std::vector<std::uint64_t> out(tasks);
+    const double stealing_for_ns =
+        ns_per_task(tasks, [&] { pool.parallel_for(0, tasks, [&](std::size_t i) { out[i] = i; }); });
+
+    exemplar::ThreadPool batch(threads);
+    const double batch_run_ns = ns_per_task(tasks, [&] { batch.run(tasks, [&](std::size_t i) { out[i] = i + 1; }); });
+    const double chunked_for_ns =
+        ns_per_task(tasks, [&] { exemplar::parallel_for(tasks, [&](std::size_t i) { out[i] = i + 2; }, batch); });
+    std::cout << "parallel_for (grain 1): " << stealing_for_ns << " ns/index, ThreadPool::run " << batch_run_ns
+              << " ns/index, chunked parallel_for " << chunked_for_ns << " ns/index" << std::endl;
+
+    g_sink = g_sink + done.load() + out[tasks / 2];
+    std::cout << "[" << g_sink << "]" << std::endl;
+    return 0;
+}
@@ -0,0 +1,122 @@
+#include "ParallelAlgorithms.h"
+#include "ResizingArray.h"
+#include "ThreadPool.h"
+#include "WorkStealingPool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <span>
+#include <thread>
+#include <vector>
+
+// Sorts a ResizingArray<std::uint64_t> of random keys with a recursive
+// parallel quicksort on WorkStealingPool (each partition step spawns the
+// left half and recurses into the right), for pools of 1, 2, 4, ... up to
+// max_threads. Prints each time next to std::sort on one thread and to
+// parallel_sort (bottom-up merge sort on a ThreadPool of the same size).
+//
+// Usage: WorkStealingQuicksort [element_count] [max_threads]
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Below this many elements a partition is sorted serially; spawning costs
+// more than it saves.
+constexpr std::size_t k_serial_cutoff = 8 * 1024;
+
+std::uint64_t key(std::size_t i) {
+    std::uint64_t x = (i + 1) * 0x9E3779B97F4A7C15ULL;
+    x ^= x >> 29;
+    x *= 0xBF58476D1CE4E5B9ULL;
+    x ^= x >> 32;
+    return x;
+}
+
+void parallel_quicksort(exemplar::WorkStealingPool& pool, std::span<std::uint64_t> data) {
+    if (data.size() <= k_serial_cutoff) {
+        std::sort(data.begin(), data.end());
+        return;
+    }
+
+    const std::uint64_t a = data.front();
+    const std::uint64_t b = data[data.size() / 2];
+    const std::uint64_t c = data.back();
+    const std::uint64_t pivot = std::max(std::min(a, b), std::min(std::max(a, b), c));
+
+    // Split off the keys below the pivot. Only if there are none (the
+    // pivot is the smallest key) take a second pass to strip the keys
+    // equal to it, so runs of equal keys still shrink every step.
+    const auto less_end = std::partition(data.begin(), data.end(), [&](std::uint64_t x) { return x < pivot; });
+    const auto equal_end = less_end != data.begin()
+                               ? less_end
+                               : std::partition(less_end, data.end(), [&](std::uint64_t x) { return x == pivot; });
+    const std::span<std::uint64_t> left(data.begin(), less_end);
+    const std::span<std::uint64_t> right(equal_end, data.end());
+
+    exemplar::TaskGroup group(pool);
+    group.spawn([&pool, left] { parallel_quicksort(pool, left); });
+    parallel_quicksort(pool, right);
+    group.wait();
+}
+
+std::span<std::uint64_t> all_of(exemplar::ResizingArray<std::uint64_t>& data) {
+    return std::span(data.data(), data.size());
+}
+
+void fill(exemplar::ResizingArray<std::uint64_t>& data) {
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        data[i] = key(i);
+    }
+}
+
+template <typename Fn>
+double time_ms(exemplar::ResizingArray<std::uint64_t>& data, Fn&& fn) {
+    fill(data);
+    const auto start = Clock::now();
+    fn();
+    const double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    if (!std::ranges::is_sorted(all_of(data))) {
+        std::cerr << "not sorted" << std::endl;
+    }
+    return ms;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 20'000'000;
+    const std::size_t max_threads =
+        argc > 2 ? std::strtoull(argv[2], nullptr, 10) : std::max(1u, std::thread::hardware_concurrency());
+
+    exemplar::ResizingArray<std::uint64_t> data;
+    data.resize_uninitialized(count);
+
+    const double serial_ms = time_ms(data, [&] { std::ranges::sort(all_of(data)); });
+    std::cout << "elements: " << count << ", std::sort: " << serial_ms << " ms" << std::endl;
+
+    std::vector<std::size_t> thread_counts;
+    for (std::size_t threads = 1; threads < max_threads; threads *= 2) {
+        thread_counts.push_back(threads);
+    }
+    thread_counts.push_back(max_threads);
+
+    for (std::size_t threads : thread_counts) {
+        exemplar::WorkStealingPool stealing(threads);
+        const double quicksort_ms =
+            time_ms(data, [&] { parallel_quicksort(stealing, all_of(data)); });
+
+        exemplar::ThreadPool batch(threads);
+        const double merge_sort_ms = time_ms(data, [&] { exemplar::parallel_sort(data, std::less<>{}, batch); });
+
+        std::cout << threads << " threads: work-stealing quicksort " << quicksort_ms << " ms (x"
+                  << serial_ms / quicksort_ms << "), parallel_sort " << merge_sort_ms << " ms (x"
+                  << serial_ms / merge_sort_ms << ")" << std::endl;
+    }
+
+    return 0;
+}
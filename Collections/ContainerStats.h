@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+
+namespace collections
+{
+    // Stats policies for the Collections containers. A container calls the
+    // hooks below at the points they name and exposes the policy through
+    // stats().
+    //
+    // NoStats is the default: its hooks are empty inline functions and it
+    // is stored with [[no_unique_address]], so it compiles away entirely.
+    struct NoStats
+    {
+        void on_allocation(size_t) noexcept {}
+        void on_growth(size_t, size_t, size_t) noexcept {}
+    };
+
+    // Plain counters, for sizing containers from real workloads. Not
+    // synchronized: like the container it belongs to, one thread at a time.
+    struct CountingStats
+    {
+        size_t allocations = 0;
+        size_t bytes_allocated = 0;
+        size_t growths = 0;
+        size_t bytes_moved = 0;
+        size_t peak_capacity = 0;
+
+        void on_allocation(size_t bytes) noexcept
+        {
+            ++allocations;
+            bytes_allocated += bytes;
+        }
+
+        // capacity is in elements; moved counts the bytes of the elements
+        // carried over into the new storage.
+        void on_growth(size_t, size_t new_capacity, size_t moved) noexcept
+        {
+            ++growths;
+            bytes_moved += moved;
+            if (new_capacity > peak_capacity)
+            {
+                peak_capacity = new_capacity;
+            }
+        }
+    };
+}
@@ -3,22 +3,24 @@
 #include <stdexcept>
 #include <string>
 #include <iostream>
+#include <utility>
 
 namespace collections
 {
-    template <typename T>
-    ResizingArray<T>::ResizingArray() : ResizingArray(1) {}
+    template <typename T, typename Stats>
+    ResizingArray<T, Stats>::ResizingArray() : ResizingArray(1) {}
 
-    template <typename T>
-    ResizingArray<T>::ResizingArray(size_t initial_capacity)
+    template <typename T, typename Stats>
+    ResizingArray<T, Stats>::ResizingArray(size_t initial_capacity)
     {
         m_data = std::make_unique<T[]>(initial_capacity);
+        m_stats.on_allocation(initial_capacity * sizeof(T));
         m_capacity = initial_capacity;
         m_size = 0;
     }
 
-    template <typename T>
-    void ResizingArray<T>::print() const
+    template <typename T, typename Stats>
+    void ResizingArray<T, Stats>::print() const
     {
         for (size_t i = 0; i < size(); ++i)
         {
@@ -33,8 +35,8 @@ namespace collections
         std::cout << "Size = " << size() << std::endl;
     }
 
-    template <typename T>
-    void ResizingArray<T>::push_back(const T& value)
+    template <typename T, typename Stats>
+    void ResizingArray<T, Stats>::push_back(const T& value)
     {
         if (m_size == m_capacity)
         {
@@ -44,34 +46,59 @@ namespace collections
         m_data[m_size++] = value;
     }
 
-    template <typename T>
-    void ResizingArray<T>::resize(size_t capacity)
+    template <typename T, typename Stats>
+    void ResizingArray<T, Stats>::resize(size_t capacity)
     {
-        std::cout << "Invoking resizing operation" << std::endl;
         std::unique_ptr<T[]> temp = std::make_unique<T[]>(capacity);
+        m_stats.on_allocation(capacity * sizeof(T));
         for (size_t i = 0; i < size(); ++i)
         {
-            temp[i] = m_data[i];
+            temp[i] = std::move(m_data[i]);
         }
 
+        m_stats.on_growth(m_capacity, capacity, size() * sizeof(T));
         m_data = std::move(temp);
         m_capacity = capacity;
     }
 
-    template <typename T>
-    size_t ResizingArray<T>::size() const
+    template <typename T, typename Stats>
+    T* ResizingArray<T, Stats>::data()
+    {
+        return m_data.get();
+    }
+
+    template <typename T, typename Stats>
+    const T* ResizingArray<T, Stats>::data() const
+    {
+        return m_data.get();
+    }
+
+    template <typename T, typename Stats>
+    size_t ResizingArray<T, Stats>::size() const
     {
         return m_size;
     }
 
-    template <typename T>
-    bool ResizingArray<T>::empty() const
+    template <typename T, typename Stats>
+    bool ResizingArray<T, Stats>::empty() const
     {
         return m_size == 0;
     }
 
-    template <typename T>
-    T& ResizingArray<T>::operator[](size_t index)
+    template <typename T, typename Stats>
+    size_t ResizingArray<T, Stats>::capacity() const
+    {
+        return m_capacity;
+    }
+
+    template <typename T, typename Stats>
+    const Stats& ResizingArray<T, Stats>::stats() const
+    {
+        return m_stats;
+    }
+
+    template <typename T, typename Stats>
+    T& ResizingArray<T, Stats>::operator[](size_t index)
     {
         if (index >= size())
         {
@@ -81,8 +108,8 @@ namespace collections
         return m_data[index];
     }
 
-    template <typename T>
-    const T& ResizingArray<T>::operator[](size_t index) const
+    template <typename T, typename Stats>
+    const T& ResizingArray<T, Stats>::operator[](size_t index) const
     {
         if (index >= size())
         {
@@ -98,4 +125,6 @@ namespace collections
     template class ResizingArray<double>;
     template class ResizingArray<char>;
     template class ResizingArray<std::string>;
+    template class ResizingArray<int, CountingStats>;
+    template class ResizingArray<std::string, CountingStats>;
 }
\ No newline at end of file
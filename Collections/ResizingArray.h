@@ -1,11 +1,14 @@
 #pragma once
 
+#include "ContainerStats.h"
+
 #include <cstddef>
 #include <memory>
 
 namespace collections
 {
-    template <typename T>
+    // Stats is a policy from ContainerStats.h; NoStats costs nothing.
+    template <typename T, typename Stats = NoStats>
     class ResizingArray
     {
     public:
@@ -15,8 +18,12 @@ namespace collections
         void push_back(const T& value);
         [[nodiscard]] T& operator[](size_t index);
         [[nodiscard]] const T& operator[](size_t index) const;
+        [[nodiscard]] T* data();
+        [[nodiscard]] const T* data() const;
         [[nodiscard]] size_t size() const;
         [[nodiscard]] bool empty() const;
+        [[nodiscard]] size_t capacity() const;
+        [[nodiscard]] const Stats& stats() const;
 
         void print() const;
     private:
@@ -26,5 +33,6 @@ namespace collections
         std::unique_ptr<T[]> m_data;
         size_t m_size = 0;
         size_t m_capacity = 0;
+        [[no_unique_address]] Stats m_stats;
     };
 };
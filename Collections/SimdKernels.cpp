@@ -0,0 +1,206 @@
+#include "SimdKernels.h"
+#include "SimdKernelsDetail.h"
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+
+namespace collections::simd
+{
+    namespace
+    {
+        SimdLevel detect_level()
+        {
+#if defined(COLLECTIONS_SIMD_X86)
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") &&
+                __builtin_cpu_supports("avx512dq") && __builtin_cpu_supports("avx512vl"))
+            {
+                return SimdLevel::Avx512;
+            }
+            if (__builtin_cpu_supports("avx2"))
+            {
+                return SimdLevel::Avx2;
+            }
+            return SimdLevel::Sse2;
+#else
+            return SimdLevel::Scalar;
+#endif
+        }
+
+        const SimdLevel g_detected_level = detect_level();
+        std::atomic<SimdLevel> g_active_level{g_detected_level};
+
+        // Calls fn with the Kernels<T> type of the active level.
+        template <typename T, typename Fn>
+        decltype(auto) dispatch(Fn&& fn)
+        {
+            switch (g_active_level.load(std::memory_order_relaxed))
+            {
+#if defined(COLLECTIONS_SIMD_X86)
+            case SimdLevel::Avx512:
+                return fn(detail::avx512::Kernels<T>{});
+            case SimdLevel::Avx2:
+                return fn(detail::avx2::Kernels<T>{});
+            case SimdLevel::Sse2:
+                return fn(detail::sse2::Kernels<T>{});
+#endif
+            default:
+                return fn(detail::scalar::Kernels<T>{});
+            }
+        }
+    }
+
+    SimdLevel detected_level()
+    {
+        return g_detected_level;
+    }
+
+    SimdLevel active_level()
+    {
+        return g_active_level.load(std::memory_order_relaxed);
+    }
+
+    void set_level(SimdLevel level)
+    {
+        if (level > g_detected_level)
+        {
+            throw std::invalid_argument("SIMD level is not supported on this CPU");
+        }
+        g_active_level.store(level, std::memory_order_relaxed);
+    }
+
+    const char* level_name(SimdLevel level)
+    {
+        switch (level)
+        {
+        case SimdLevel::Sse2:
+            return "SSE2";
+        case SimdLevel::Avx2:
+            return "AVX2";
+        case SimdLevel::Avx512:
+            return "AVX-512";
+        default:
+            return "scalar";
+        }
+    }
+
+    template <typename T>
+    size_t find(const ResizingArray<T>& array, T value)
+    {
+        return dispatch<T>([&](auto kernels) { return kernels.find(array.data(), array.size(), value); });
+    }
+
+    template <typename T>
+    size_t count(const ResizingArray<T>& array, T value)
+    {
+        return dispatch<T>([&](auto kernels) { return kernels.count(array.data(), array.size(), value); });
+    }
+
+    template <typename T>
+    MinMax<T> min_max(const ResizingArray<T>& array)
+    {
+        if (array.empty())
+        {
+            throw std::invalid_argument("min_max of an empty ResizingArray");
+        }
+        return dispatch<T>([&](auto kernels) { return kernels.min_max(array.data(), array.size()); });
+    }
+
+    template <typename T>
+    Sum<T> sum(const ResizingArray<T>& array)
+    {
+        return dispatch<T>([&](auto kernels) { return kernels.sum(array.data(), array.size()); });
+    }
+
+    template <typename T>
+    Sum<T> dot(const ResizingArray<T>& left, const ResizingArray<T>& right)
+    {
+        if (left.size() != right.size())
+        {
+            throw std::invalid_argument("dot of ResizingArrays with different sizes");
+        }
+        return dispatch<T>([&](auto kernels) { return kernels.dot(left.data(), right.data(), left.size()); });
+    }
+
+#define COLLECTIONS_INSTANTIATE_SIMD_KERNELS(T)                                      \
+    template size_t find<T>(const ResizingArray<T>&, T);                             \
+    template size_t count<T>(const ResizingArray<T>&, T);                            \
+    template MinMax<T> min_max<T>(const ResizingArray<T>&);                          \
+    template Sum<T> sum<T>(const ResizingArray<T>&);                                 \
+    template Sum<T> dot<T>(const ResizingArray<T>&, const ResizingArray<T>&);
+
+    COLLECTIONS_INSTANTIATE_SIMD_KERNELS(int)
+    COLLECTIONS_INSTANTIATE_SIMD_KERNELS(float)
+    COLLECTIONS_INSTANTIATE_SIMD_KERNELS(double)
+    COLLECTIONS_INSTANTIATE_SIMD_KERNELS(char)
+
+#undef COLLECTIONS_INSTANTIATE_SIMD_KERNELS
+}
+
+// The reference implementation, and the only one on non-x86 builds.
+namespace collections::simd::detail::scalar
+{
+    template <typename T>
+    size_t Kernels<T>::find(const T* data, size_t size, T value)
+    {
+        for (size_t i = 0; i < size; ++i)
+        {
+            if (data[i] == value)
+            {
+                return i;
+            }
+        }
+        return size;
+    }
+
+    template <typename T>
+    size_t Kernels<T>::count(const T* data, size_t size, T value)
+    {
+        size_t total = 0;
+        for (size_t i = 0; i < size; ++i)
+        {
+            total += data[i] == value;
+        }
+        return total;
+    }
+
+    template <typename T>
+    MinMax<T> Kernels<T>::min_max(const T* data, size_t size)
+    {
+        MinMax<T> result{data[0], data[0]};
+        for (size_t i = 1; i < size; ++i)
+        {
+            result.min = std::min(result.min, data[i]);
+            result.max = std::max(result.max, data[i]);
+        }
+        return result;
+    }
+
+    template <typename T>
+    Sum<T> Kernels<T>::sum(const T* data, size_t size)
+    {
+        Sum<T> total = 0;
+        for (size_t i = 0; i < size; ++i)
+        {
+            total += static_cast<Sum<T>>(data[i]);
+        }
+        return total;
+    }
+
+    template <typename T>
+    Sum<T> Kernels<T>::dot(const T* left, const T* right, size_t size)
+    {
+        Sum<T> total = 0;
+        for (size_t i = 0; i < size; ++i)
+        {
+            total += static_cast<Sum<T>>(left[i]) * static_cast<Sum<T>>(right[i]);
+        }
+        return total;
+    }
+
+    template struct Kernels<int>;
+    template struct Kernels<float>;
+    template struct Kernels<double>;
+    template struct Kernels<char>;
+}
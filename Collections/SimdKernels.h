@@ -0,0 +1,67 @@
+#pragma once
+
+#include "ResizingArray.h"
+
+#include <cstddef>
+#include <type_traits>
+
+// Vectorized scans over the numeric ResizingArray instantiations
+// (int, float, double, char).
+//
+// Each kernel is compiled several times: as plain scalar code and, on
+// x86-64, for SSE2, AVX2 and AVX-512 vector widths. The widest version the
+// CPU supports is picked once at startup; set_simd_level() can force a
+// narrower one (e.g. to compare them).
+namespace collections::simd
+{
+    enum class SimdLevel
+    {
+        Scalar,
+        Sse2,
+        Avx2,
+        Avx512
+    };
+
+    // Widest level this CPU and build support.
+    [[nodiscard]] SimdLevel detected_level();
+
+    [[nodiscard]] SimdLevel active_level();
+
+    // Throws std::invalid_argument for a level above detected_level().
+    void set_level(SimdLevel level);
+
+    [[nodiscard]] const char* level_name(SimdLevel level);
+
+    template <typename T>
+    struct MinMax
+    {
+        T min;
+        T max;
+    };
+
+    // sum and dot accumulate in 64-bit integers or doubles, so int and char
+    // sums do not overflow and float sums keep their precision.
+    template <typename T>
+    using Sum = std::conditional_t<std::is_floating_point_v<T>, double, long long>;
+
+    // Index of the first element equal to value, or array.size() if none.
+    template <typename T>
+    [[nodiscard]] size_t find(const ResizingArray<T>& array, T value);
+
+    template <typename T>
+    [[nodiscard]] size_t count(const ResizingArray<T>& array, T value);
+
+    // Throws std::invalid_argument for an empty array. If the array holds a
+    // NaN, the result is unspecified.
+    template <typename T>
+    [[nodiscard]] MinMax<T> min_max(const ResizingArray<T>& array);
+
+    // Floating-point results can differ from a left-to-right loop in the
+    // last bits, since lanes are added in a different order.
+    template <typename T>
+    [[nodiscard]] Sum<T> sum(const ResizingArray<T>& array);
+
+    // Throws std::invalid_argument if the arrays differ in size.
+    template <typename T>
+    [[nodiscard]] Sum<T> dot(const ResizingArray<T>& left, const ResizingArray<T>& right);
+}
@@ -0,0 +1,5 @@
+// AVX2 build of the SIMD kernels; CMakeLists.txt sets its compiler flags.
+
+#define COLLECTIONS_SIMD_NAMESPACE avx2
+#define COLLECTIONS_SIMD_VECTOR_BYTES 32
+#include "SimdKernelsImpl.h"
@@ -0,0 +1,5 @@
+// AVX-512 build of the SIMD kernels; CMakeLists.txt sets its compiler flags.
+
+#define COLLECTIONS_SIMD_NAMESPACE avx512
+#define COLLECTIONS_SIMD_VECTOR_BYTES 64
+#include "SimdKernelsImpl.h"
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "SimdKernels.h"
+
+#include <cstddef>
+
+// Kernels<T> is declared once per instruction set, each in its own
+// namespace. scalar is defined in SimdKernels.cpp, the others in
+// SimdKernelsImpl.h, which each SimdKernels<Isa>.cpp includes after
+// naming its namespace and vector width.
+#define COLLECTIONS_DECLARE_SIMD_KERNELS(isa)                                       \
+    namespace collections::simd::detail::isa                                        \
+    {                                                                               \
+        template <typename T>                                                       \
+        struct Kernels                                                              \
+        {                                                                           \
+            static size_t find(const T* data, size_t size, T value);                \
+            static size_t count(const T* data, size_t size, T value);               \
+            static MinMax<T> min_max(const T* data, size_t size);                   \
+            static Sum<T> sum(const T* data, size_t size);                          \
+            static Sum<T> dot(const T* left, const T* right, size_t size);          \
+        };                                                                          \
+    }
+
+COLLECTIONS_DECLARE_SIMD_KERNELS(scalar)
+COLLECTIONS_DECLARE_SIMD_KERNELS(sse2)
+COLLECTIONS_DECLARE_SIMD_KERNELS(avx2)
+COLLECTIONS_DECLARE_SIMD_KERNELS(avx512)
+
+#undef COLLECTIONS_DECLARE_SIMD_KERNELS
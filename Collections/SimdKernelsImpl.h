@@ -0,0 +1,321 @@
+// No include guard: this file is compiled once per instruction set. The
+// including SimdKernels<Isa>.cpp defines COLLECTIONS_SIMD_NAMESPACE and
+// COLLECTIONS_SIMD_VECTOR_BYTES and is built with that instruction set's
+// compiler flags (see CMakeLists.txt).
+//
+// The kernels use the GCC/Clang vector extensions rather than intrinsics,
+// so one source serves every vector width; the compiler maps each vector
+// operation onto the instructions the flags allow.
+
+#include "SimdKernelsDetail.h"
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if !defined(COLLECTIONS_SIMD_NAMESPACE) || !defined(COLLECTIONS_SIMD_VECTOR_BYTES)
+#error "Define COLLECTIONS_SIMD_NAMESPACE and COLLECTIONS_SIMD_VECTOR_BYTES before including SimdKernelsImpl.h"
+#endif
+
+namespace collections::simd::detail::COLLECTIONS_SIMD_NAMESPACE
+{
+    namespace
+    {
+        template <typename T, size_t Lanes>
+        struct VectorOf
+        {
+            typedef T type __attribute__((vector_size(sizeof(T) * Lanes)));
+        };
+
+        // Elements of T per vector register.
+        template <typename T>
+        constexpr size_t k_lanes = COLLECTIONS_SIMD_VECTOR_BYTES / sizeof(T);
+
+        template <typename T>
+        using Vector = typename VectorOf<T, k_lanes<T>>::type;
+
+        // Lane type that sum and dot accumulate in before the final total.
+        template <typename T>
+        using Wide = std::conditional_t<std::is_floating_point_v<T>, double, int64_t>;
+
+        // sum and dot fill a register with wide lanes, so they load only as
+        // many elements of T at a time as it holds wide lanes.
+        template <typename T>
+        constexpr size_t k_wide_lanes = COLLECTIONS_SIMD_VECTOR_BYTES / sizeof(Wide<T>);
+
+        template <typename T>
+        using WideVector = typename VectorOf<Wide<T>, k_wide_lanes<T>>::type;
+
+        // char is handled as int32 lanes holding four bytes each; see
+        // byte_lane. Converting narrow char vectors instead is lowered to
+        // scalar code by GCC.
+        using ByteQuads = Vector<int32_t>;
+
+        // Blocks of char accumulated before flushing to the total. One block
+        // adds at most 4 * 128 * 128 = 2^16 to a lane, so 2^14 blocks stay
+        // below 2^31.
+        constexpr size_t k_byte_flush_blocks = size_t{1} << 14;
+
+        // Local stand-ins for std::min and std::max. An inline std function
+        // instantiated here would be compiled for this instruction set, and
+        // the linker could keep that copy for callers in baseline code too.
+        template <typename T>
+        T smaller(T left, T right)
+        {
+            return right < left ? right : left;
+        }
+
+        template <typename T>
+        T larger(T left, T right)
+        {
+            return left < right ? right : left;
+        }
+
+        // Unaligned load.
+        template <typename T>
+        Vector<T> load(const T* data)
+        {
+            Vector<T> vector;
+            std::memcpy(&vector, data, sizeof(vector));
+            return vector;
+        }
+
+        template <typename Mask>
+        bool any(const Mask& mask)
+        {
+            uint64_t words[sizeof(Mask) / sizeof(uint64_t)];
+            std::memcpy(words, &mask, sizeof(mask));
+            uint64_t bits = 0;
+            for (uint64_t word : words)
+            {
+                bits |= word;
+            }
+            return bits != 0;
+        }
+
+        // Loads k_wide_lanes<T> elements, widened.
+        template <typename T>
+        WideVector<T> load_wide(const T* data)
+        {
+            typename VectorOf<T, k_wide_lanes<T>>::type narrow;
+            std::memcpy(&narrow, data, sizeof(narrow));
+            return __builtin_convertvector(narrow, WideVector<T>);
+        }
+
+        // Byte number Index of every int32 lane, sign-extended (char is signed on
+        // the x86 targets these kernels are built for).
+        template <int Index>
+        ByteQuads byte_lane(const ByteQuads& quads)
+        {
+            return (quads << (24 - 8 * Index)) >> 24;
+        }
+
+        ByteQuads load_quads(const char* data)
+        {
+            ByteQuads quads;
+            std::memcpy(&quads, data, sizeof(quads));
+            return quads;
+        }
+
+        template <typename Total, typename V>
+        Total add_lanes(const V& vector)
+        {
+            Total total = 0;
+            for (size_t lane = 0; lane < sizeof(V) / sizeof(vector[0]); ++lane)
+            {
+                total += static_cast<Total>(vector[lane]);
+            }
+            return total;
+        }
+    }
+
+    template <typename T>
+    size_t Kernels<T>::find(const T* data, size_t size, T value)
+    {
+        constexpr size_t lanes = k_lanes<T>;
+        const Vector<T> needle = Vector<T>{} + value;
+
+        // Four vectors per test, then a scalar pass over the block that
+        // matched (or the tail) to find the exact index.
+        size_t i = 0;
+        for (; i + 4 * lanes <= size; i += 4 * lanes)
+        {
+            const auto hits = (load(data + i) == needle) | (load(data + i + lanes) == needle) |
+                              (load(data + i + 2 * lanes) == needle) | (load(data + i + 3 * lanes) == needle);
+            if (any(hits))
+            {
+                break;
+            }
+        }
+
+        for (; i < size; ++i)
+        {
+            if (data[i] == value)
+            {
+                return i;
+            }
+        }
+        return size;
+    }
+
+    template <typename T>
+    size_t Kernels<T>::count(const T* data, size_t size, T value)
+    {
+        constexpr size_t lanes = k_lanes<T>;
+        // Lanes of a comparison mask are 0 or -1 and as wide as T, so char
+        // counters are flushed before they reach 128.
+        constexpr size_t flush_blocks = sizeof(T) == 1 ? 127 : size_t{1} << 30;
+        const Vector<T> needle = Vector<T>{} + value;
+
+        size_t total = 0;
+        size_t i = 0;
+        while (i + lanes <= size)
+        {
+            decltype(needle == needle) counters{};
+            const size_t blocks = smaller(flush_blocks, (size - i) / lanes);
+            for (size_t block = 0; block < blocks; ++block, i += lanes)
+            {
+                counters -= load(data + i) == needle;
+            }
+            total += add_lanes<size_t>(counters);
+        }
+
+        for (; i < size; ++i)
+        {
+            total += data[i] == value;
+        }
+        return total;
+    }
+
+    template <typename T>
+    MinMax<T> Kernels<T>::min_max(const T* data, size_t size)
+    {
+        constexpr size_t lanes = k_lanes<T>;
+        MinMax<T> result{data[0], data[0]};
+        size_t i = 0;
+
+        if (size >= lanes)
+        {
+            Vector<T> low = load(data);
+            Vector<T> high = low;
+            for (i = lanes; i + lanes <= size; i += lanes)
+            {
+                const Vector<T> vector = load(data + i);
+                low = vector < low ? vector : low;
+                high = vector > high ? vector : high;
+            }
+
+            for (size_t lane = 0; lane < lanes; ++lane)
+            {
+                result.min = smaller<T>(result.min, low[lane]);
+                result.max = larger<T>(result.max, high[lane]);
+            }
+        }
+
+        for (; i < size; ++i)
+        {
+            result.min = smaller(result.min, data[i]);
+            result.max = larger(result.max, data[i]);
+        }
+        return result;
+    }
+
+    // sum and dot keep four independent accumulators so consecutive adds do
+    // not wait on each other (floating-point add latency is several cycles).
+    template <typename T>
+    Sum<T> Kernels<T>::sum(const T* data, size_t size)
+    {
+        static_assert(std::is_signed_v<char>);
+
+        Sum<T> total = 0;
+        size_t i = 0;
+        if constexpr (std::is_same_v<T, char>)
+        {
+            constexpr size_t bytes = sizeof(ByteQuads);
+            while (i + bytes <= size)
+            {
+                ByteQuads acc{};
+                const size_t blocks = smaller(k_byte_flush_blocks, (size - i) / bytes);
+                for (size_t block = 0; block < blocks; ++block, i += bytes)
+                {
+                    const ByteQuads quads = load_quads(data + i);
+                    acc += (byte_lane<0>(quads) + byte_lane<1>(quads)) + (byte_lane<2>(quads) + byte_lane<3>(quads));
+                }
+                total += add_lanes<Sum<T>>(acc);
+            }
+        }
+        else
+        {
+            constexpr size_t lanes = k_wide_lanes<T>;
+            WideVector<T> acc0{}, acc1{}, acc2{}, acc3{};
+            for (; i + 4 * lanes <= size; i += 4 * lanes)
+            {
+                acc0 += load_wide(data + i);
+                acc1 += load_wide(data + i + lanes);
+                acc2 += load_wide(data + i + 2 * lanes);
+                acc3 += load_wide(data + i + 3 * lanes);
+            }
+            total += add_lanes<Sum<T>>((acc0 + acc1) + (acc2 + acc3));
+        }
+
+        for (; i < size; ++i)
+        {
+            total += static_cast<Sum<T>>(data[i]);
+        }
+        return total;
+    }
+
+    template <typename T>
+    Sum<T> Kernels<T>::dot(const T* left, const T* right, size_t size)
+    {
+        Sum<T> total = 0;
+        size_t i = 0;
+        if constexpr (std::is_same_v<T, char>)
+        {
+            constexpr size_t bytes = sizeof(ByteQuads);
+            while (i + bytes <= size)
+            {
+                ByteQuads acc0{}, acc1{};
+                const size_t blocks = smaller(k_byte_flush_blocks, (size - i) / bytes);
+                for (size_t block = 0; block < blocks; ++block, i += bytes)
+                {
+                    const ByteQuads a = load_quads(left + i);
+                    const ByteQuads b = load_quads(right + i);
+                    acc0 += byte_lane<0>(a) * byte_lane<0>(b) + byte_lane<1>(a) * byte_lane<1>(b);
+                    acc1 += byte_lane<2>(a) * byte_lane<2>(b) + byte_lane<3>(a) * byte_lane<3>(b);
+                }
+                total += add_lanes<Sum<T>>(acc0) + add_lanes<Sum<T>>(acc1);
+            }
+        }
+        else
+        {
+            constexpr size_t lanes = k_wide_lanes<T>;
+            using Accumulator = WideVector<T>;
+            auto multiply_add = [&](Accumulator& acc, size_t offset)
+            {
+                acc += load_wide(left + offset) * load_wide(right + offset);
+            };
+
+            Accumulator acc0{}, acc1{}, acc2{}, acc3{};
+            for (; i + 4 * lanes <= size; i += 4 * lanes)
+            {
+                multiply_add(acc0, i);
+                multiply_add(acc1, i + lanes);
+                multiply_add(acc2, i + 2 * lanes);
+                multiply_add(acc3, i + 3 * lanes);
+            }
+            total += add_lanes<Sum<T>>((acc0 + acc1) + (acc2 + acc3));
+        }
+
+        for (; i < size; ++i)
+        {
+            total += static_cast<Sum<T>>(left[i]) * static_cast<Sum<T>>(right[i]);
+        }
+        return total;
+    }
+
+    template struct Kernels<int>;
+    template struct Kernels<float>;
+    template struct Kernels<double>;
+    template struct Kernels<char>;
+}
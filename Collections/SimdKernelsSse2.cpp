@@ -0,0 +1,5 @@
+// SSE2 build of the SIMD kernels; CMakeLists.txt sets its compiler flags.
+
+#define COLLECTIONS_SIMD_NAMESPACE sse2
+#define COLLECTIONS_SIMD_VECTOR_BYTES 16
+#include "SimdKernelsImpl.h"
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace exemplar::detail {
+
+// Shorthands for the allocator_traits questions an allocator-aware
+// container asks when it is copied, moved or swapped.
+template <typename Allocator>
+inline constexpr bool propagate_on_copy_assignment_v =
+    std::allocator_traits<Allocator>::propagate_on_container_copy_assignment::value;
+
+template <typename Allocator>
+inline constexpr bool propagate_on_move_assignment_v =
+    std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value;
+
+template <typename Allocator>
+inline constexpr bool propagate_on_swap_v = std::allocator_traits<Allocator>::propagate_on_container_swap::value;
+
+template <typename Allocator>
+inline constexpr bool always_equal_v = std::allocator_traits<Allocator>::is_always_equal::value;
+
+// Move assignment can steal the other container's memory without
+// allocating when the allocator travels with it or all instances are equal.
+template <typename Allocator>
+inline constexpr bool nothrow_move_assignable_v = propagate_on_move_assignment_v<Allocator> || always_equal_v<Allocator>;
+
+template <typename Allocator, typename U>
+using rebind_alloc_t = typename std::allocator_traits<Allocator>::template rebind_alloc<U>;
+
+// Allocates one node from alloc and constructs it from args.
+// The memory is returned to alloc if the constructor throws.
+// Containers keep raw node pointers, so the allocator's pointer type must be
+// a plain pointer (true for std::allocator and std::pmr::polymorphic_allocator).
+template <typename NodeAllocator, typename... Args>
+[[nodiscard]] typename std::allocator_traits<NodeAllocator>::value_type* new_node(NodeAllocator& alloc,
+                                                                                  Args&&... args) {
+    using Traits = std::allocator_traits<NodeAllocator>;
+    static_assert(std::is_pointer_v<typename Traits::pointer>, "fancy allocator pointers are not supported");
+
+    auto* node = Traits::allocate(alloc, 1);
+    try {
+        Traits::construct(alloc, node, std::forward<Args>(args)...);
+    } catch (...) {
+        Traits::deallocate(alloc, node, 1);
+        throw;
+    }
+    return node;
+}
+
+template <typename NodeAllocator>
+void delete_node(NodeAllocator& alloc, typename std::allocator_traits<NodeAllocator>::value_type* node) noexcept {
+    using Traits = std::allocator_traits<NodeAllocator>;
+    Traits::destroy(alloc, node);
+    Traits::deallocate(alloc, node, 1);
+}
+
+} // namespace exemplar::detail
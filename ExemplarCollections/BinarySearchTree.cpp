@@ -1,6 +1,8 @@
 #include "BinarySearchTree.h"
 
+#include <memory_resource>
 #include <string>
 
 template class exemplar::BinarySearchTree<int>;
 template class exemplar::BinarySearchTree<std::string>;
+template class exemplar::BinarySearchTree<int, std::less<int>, std::pmr::polymorphic_allocator<int>>;
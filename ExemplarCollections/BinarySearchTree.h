@@ -1,8 +1,12 @@
 #pragma once
 
+#include "AllocatorSupport.h"
+#include "Transparent.h"
+
 #include <cstddef>
 #include <functional>
 #include <memory>
+#include <memory_resource>
 #include <optional>
 #include <stdexcept>
 #include <utility>
@@ -13,26 +17,79 @@ namespace exemplar {
 // Minimal Binary Search Tree (BST).
 // Default ordering uses std::less<T>.
 // This implementation is intentionally not self-balancing.
-template <typename T, typename Compare = std::less<T>>
+//
+// Nodes are allocated from Allocator (rebound to the node type); with a
+// std::pmr allocator the elements are constructed with it too.
+template <typename T, typename Compare = std::less<T>, typename Allocator = std::allocator<T>>
 class BinarySearchTree {
 public:
+    using allocator_type = Allocator;
+
     BinarySearchTree() = default;
 
-    BinarySearchTree(const BinarySearchTree& other) : root_(clone(other.root_)), size_(other.size_), compare_(other.compare_) {}
+    explicit BinarySearchTree(const Allocator& alloc) noexcept : node_alloc_(alloc) {}
+
+    BinarySearchTree(const BinarySearchTree& other)
+        : BinarySearchTree(other,
+                           std::allocator_traits<Allocator>::select_on_container_copy_construction(other.get_allocator())) {}
+
+    BinarySearchTree(const BinarySearchTree& other, const Allocator& alloc)
+        : node_alloc_(alloc), root_(clone(other.root_)), size_(other.size_), compare_(other.compare_) {}
 
     BinarySearchTree& operator=(const BinarySearchTree& other) {
         if (this == &other) {
             return *this;
         }
 
-        BinarySearchTree copy(other);
-        swap(copy);
+        BinarySearchTree copy(other, detail::propagate_on_copy_assignment_v<Allocator> ? other.get_allocator()
+                                                                                        : get_allocator());
+        if constexpr (detail::propagate_on_copy_assignment_v<Allocator>) {
+            std::swap(node_alloc_, copy.node_alloc_);
+        }
+        swap_nodes(copy);
+        return *this;
+    }
+
+    BinarySearchTree(BinarySearchTree&& other) noexcept : node_alloc_(std::move(other.node_alloc_)) {
+        swap_nodes(other);
+    }
+
+    // Moves element by element, keeping the tree's shape, when alloc cannot
+    // free other's nodes.
+    BinarySearchTree(BinarySearchTree&& other, const Allocator& alloc) : node_alloc_(alloc) {
+        if (node_alloc_ == other.node_alloc_) {
+            swap_nodes(other);
+            return;
+        }
+
+        root_ = clone<true>(other.root_);
+        size_ = other.size_;
+        compare_ = other.compare_;
+    }
+
+    BinarySearchTree& operator=(BinarySearchTree&& other) noexcept(detail::nothrow_move_assignable_v<Allocator>) {
+        if (this == &other) {
+            return *this;
+        }
+
+        if constexpr (detail::propagate_on_move_assignment_v<Allocator>) {
+            clear();
+            node_alloc_ = std::move(other.node_alloc_);
+            swap_nodes(other);
+        } else if (node_alloc_ == other.node_alloc_) {
+            clear();
+            swap_nodes(other);
+        } else {
+            BinarySearchTree moved(std::move(other), get_allocator());
+            clear();
+            swap_nodes(moved);
+        }
         return *this;
     }
 
-    BinarySearchTree(BinarySearchTree&&) noexcept = default;
-    BinarySearchTree& operator=(BinarySearchTree&&) noexcept = default;
-    ~BinarySearchTree() = default;
+    ~BinarySearchTree() { clear(); }
+
+    [[nodiscard]] allocator_type get_allocator() const noexcept { return allocator_type(node_alloc_); }
 
     [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
     [[nodiscard]] std::size_t size() const noexcept { return size_; }
@@ -42,31 +99,34 @@ public:
     bool insert(const T& value) { return insert_impl(root_, value); }
     bool insert(T&& value) { return insert_impl(root_, std::move(value)); }
 
-    [[nodiscard]] bool contains(const T& value) const {
-        Node* cursor = root_.get();
-        while (cursor != nullptr) {
-            if (compare_(value, cursor->value)) {
-                cursor = cursor->left.get();
-            } else if (compare_(cursor->value, value)) {
-                cursor = cursor->right.get();
-            } else {
-                return true;
-            }
-        }
-        return false;
+    [[nodiscard]] bool contains(const T& value) const { return find_node(value) != nullptr; }
+
+    // Heterogeneous lookup, enabled when Compare is transparent
+    // (e.g. std::less<>), so a BinarySearchTree<std::string, std::less<>>
+    // can be searched with std::string_view or const char*.
+    template <typename Q>
+        requires transparent<Compare>
+    [[nodiscard]] bool contains(const Q& value) const {
+        return find_node(value) != nullptr;
     }
 
     // Erase by key. Returns true if element was found and removed.
     bool erase(const T& value) { return erase_impl(root_, value); }
 
+    template <typename Q>
+        requires transparent<Compare>
+    bool erase(const Q& value) {
+        return erase_impl(root_, value);
+    }
+
     [[nodiscard]] std::optional<T> min_value() const {
         if (empty()) {
             return std::nullopt;
         }
 
-        Node* cursor = root_.get();
+        const Node* cursor = root_;
         while (cursor->left) {
-            cursor = cursor->left.get();
+            cursor = cursor->left;
         }
         return cursor->value;
     }
@@ -76,9 +136,9 @@ public:
             return std::nullopt;
         }
 
-        Node* cursor = root_.get();
+        const Node* cursor = root_;
         while (cursor->right) {
-            cursor = cursor->right.get();
+            cursor = cursor->right;
         }
         return cursor->value;
     }
@@ -87,35 +147,42 @@ public:
     [[nodiscard]] std::vector<T> in_order() const {
         std::vector<T> out;
         out.reserve(size_);
-        in_order_impl(root_.get(), out);
+        in_order_impl(root_, out);
         return out;
     }
 
     void clear() noexcept {
-        root_.reset();
+        destroy_subtree(root_);
+        root_ = nullptr;
         size_ = 0;
     }
 
+    // As with the std containers, swapping trees whose allocators differ
+    // and do not propagate on swap is undefined.
     void swap(BinarySearchTree& other) noexcept {
-        std::swap(root_, other.root_);
-        std::swap(size_, other.size_);
-        std::swap(compare_, other.compare_);
+        if constexpr (detail::propagate_on_swap_v<Allocator>) {
+            std::swap(node_alloc_, other.node_alloc_);
+        }
+        swap_nodes(other);
     }
 
 private:
     struct Node {
-        explicit Node(const T& v) : value(v) {}
-        explicit Node(T&& v) : value(std::move(v)) {}
+        template <typename... Args>
+        explicit Node(const Allocator& alloc, Args&&... args)
+            : value(std::make_obj_using_allocator<T>(alloc, std::forward<Args>(args)...)) {}
 
         T value;
-        std::unique_ptr<Node> left{};
-        std::unique_ptr<Node> right{};
+        Node* left{nullptr};
+        Node* right{nullptr};
     };
 
+    using NodeAllocator = detail::rebind_alloc_t<Allocator, Node>;
+
     template <typename U>
-    bool insert_impl(std::unique_ptr<Node>& current, U&& value) {
+    bool insert_impl(Node*& current, U&& value) {
         if (!current) {
-            current = std::make_unique<Node>(std::forward<U>(value));
+            current = detail::new_node(node_alloc_, get_allocator(), std::forward<U>(value));
             ++size_;
             return true;
         }
@@ -131,7 +198,23 @@ private:
         return false;
     }
 
-    bool erase_impl(std::unique_ptr<Node>& current, const T& value) {
+    template <typename Q>
+    [[nodiscard]] const Node* find_node(const Q& value) const {
+        const Node* cursor = root_;
+        while (cursor != nullptr) {
+            if (compare_(value, cursor->value)) {
+                cursor = cursor->left;
+            } else if (compare_(cursor->value, value)) {
+                cursor = cursor->right;
+            } else {
+                return cursor;
+            }
+        }
+        return nullptr;
+    }
+
+    template <typename Q>
+    bool erase_impl(Node*& current, const Q& value) {
         if (!current) {
             return false;
         }
@@ -144,15 +227,12 @@ private:
             return erase_impl(current->right, value);
         }
 
-        // Found node to delete.
-        if (!current->left) {
-            current = std::move(current->right);
-            --size_;
-            return true;
-        }
-
-        if (!current->right) {
-            current = std::move(current->left);
+        // Found node to delete. With at most one child, the child
+        // takes its place.
+        if (!current->left || !current->right) {
+            Node* doomed = current;
+            current = current->left ? current->left : current->right;
+            detail::delete_node(node_alloc_, doomed);
             --size_;
             return true;
         }
@@ -161,24 +241,54 @@ private:
         // 1) find smallest node in right subtree (in-order successor)
         // 2) copy successor value into current
         // 3) delete successor node recursively
-        Node* successor = current->right.get();
+        Node* successor = current->right;
         while (successor->left) {
-            successor = successor->left.get();
+            successor = successor->left;
         }
 
         current->value = successor->value;
         return erase_impl(current->right, successor->value);
     }
 
-    static std::unique_ptr<Node> clone(const std::unique_ptr<Node>& node) {
+    // Copies (or, with Move, moves) the subtree's values into new nodes of
+    // the same shape. On exception, frees the nodes built so far.
+    template <bool Move = false>
+    Node* clone(Node* node) {
         if (!node) {
             return nullptr;
         }
 
-        auto new_node = std::make_unique<Node>(node->value);
-        new_node->left = clone(node->left);
-        new_node->right = clone(node->right);
-        return new_node;
+        Node* copy = nullptr;
+        if constexpr (Move) {
+            copy = detail::new_node(node_alloc_, get_allocator(), std::move(node->value));
+        } else {
+            copy = detail::new_node(node_alloc_, get_allocator(), std::as_const(node->value));
+        }
+
+        try {
+            copy->left = clone<Move>(node->left);
+            copy->right = clone<Move>(node->right);
+        } catch (...) {
+            destroy_subtree(copy);
+            throw;
+        }
+        return copy;
+    }
+
+    void destroy_subtree(Node* node) noexcept {
+        if (!node) {
+            return;
+        }
+
+        destroy_subtree(node->left);
+        destroy_subtree(node->right);
+        detail::delete_node(node_alloc_, node);
+    }
+
+    void swap_nodes(BinarySearchTree& other) noexcept {
+        std::swap(root_, other.root_);
+        std::swap(size_, other.size_);
+        std::swap(compare_, other.compare_);
     }
 
     static void in_order_impl(const Node* node, std::vector<T>& out) {
@@ -186,19 +296,27 @@ private:
             return;
         }
 
-        in_order_impl(node->left.get(), out);
+        in_order_impl(node->left, out);
         out.push_back(node->value);
-        in_order_impl(node->right.get(), out);
+        in_order_impl(node->right, out);
     }
 
-    std::unique_ptr<Node> root_{};
+    [[no_unique_address]] NodeAllocator node_alloc_{};
+    Node* root_{nullptr};
     std::size_t size_{0};
     Compare compare_{};
 };
 
-template <typename T, typename Compare>
-void swap(BinarySearchTree<T, Compare>& left, BinarySearchTree<T, Compare>& right) noexcept {
+template <typename T, typename Compare, typename Allocator>
+void swap(BinarySearchTree<T, Compare, Allocator>& left, BinarySearchTree<T, Compare, Allocator>& right) noexcept {
     left.swap(right);
 }
 
+namespace pmr {
+
+template <typename T, typename Compare = std::less<T>>
+using BinarySearchTree = exemplar::BinarySearchTree<T, Compare, std::pmr::polymorphic_allocator<T>>;
+
+} // namespace pmr
+
 } // namespace exemplar
@@ -0,0 +1,6 @@
+#include "BlockingQueue.h"
+
+#include <string>
+
+template class exemplar::BlockingQueue<int>;
+template class exemplar::BlockingQueue<std::string>;
@@ -0,0 +1,171 @@
+#pragma once
+
+#include "EventCount.h"
+#include "RingQueue.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <ranges>
+#include <utility>
+
+namespace exemplar {
+
+// An unbounded FIFO with Queue's semantics whose consumers can block until
+// items arrive, and drain many items per wakeup.
+//
+// The items sit in a RingQueue behind a std::mutex that is held only for
+// the copy in or out, so neither side sleeps while holding it. Sleeping is
+// done through an EventCount rather than a condition variable: enqueue
+// checks a waiter count and makes no syscall at all when every consumer
+// is busy, and a consumer spins briefly on an atomic item count before it
+// registers to sleep, so bursts are picked up without a context switch.
+//
+// wait_dequeue_bulk(out, max, timeout) takes everything available (up to
+// max) in one critical section, so a consumer woken by a burst handles it
+// in one go instead of waking once per item.
+template <typename T>
+class BlockingQueue {
+public:
+    using value_type = T;
+
+    BlockingQueue() = default;
+
+    // Consumers may be asleep on the EventCount.
+    BlockingQueue(const BlockingQueue&) = delete;
+    BlockingQueue& operator=(const BlockingQueue&) = delete;
+
+    // Items at some moment during the call.
+    [[nodiscard]] std::size_t size_approx() const noexcept { return size_.load(std::memory_order_relaxed); }
+
+    void enqueue(const T& value) { emplace(value); }
+    void enqueue(T&& value) { emplace(std::move(value)); }
+
+    template <typename... Args>
+    void emplace(Args&&... args) {
+        {
+            std::lock_guard lock(mutex_);
+            items_.emplace(std::forward<Args>(args)...);
+            size_.store(items_.size(), std::memory_order_relaxed);
+        }
+        events_.notify_one();
+    }
+
+    // Enqueues every element of range under one lock and wakes every
+    // sleeping consumer if there is more than one item.
+    template <std::ranges::input_range R>
+    void enqueue_range(R&& range) {
+        std::size_t added = 0;
+        {
+            std::lock_guard lock(mutex_);
+            const std::size_t before = items_.size();
+            items_.enqueue_range(std::forward<R>(range));
+            added = items_.size() - before;
+            size_.store(items_.size(), std::memory_order_relaxed);
+        }
+        if (added == 1) {
+            events_.notify_one();
+        } else if (added > 1) {
+            events_.notify_all();
+        }
+    }
+
+    // Returns false, leaving out untouched, when the queue is empty.
+    bool try_dequeue(T& out) { return try_dequeue_bulk(&out, 1) == 1; }
+
+    // Moves up to max_count items to out without waiting. Returns how many.
+    template <std::output_iterator<T&&> Out>
+    std::size_t try_dequeue_bulk(Out out, std::size_t max_count) {
+        if (size_.load(std::memory_order_relaxed) == 0) {
+            return 0;
+        }
+
+        std::lock_guard lock(mutex_);
+        const std::size_t taken = items_.dequeue_into(std::move(out), max_count);
+        size_.store(items_.size(), std::memory_order_relaxed);
+        return taken;
+    }
+
+    // Waits until an item is available.
+    void wait_dequeue(T& out) {
+        wait_until_taken([&] { return try_dequeue(out); }, std::nullopt);
+    }
+
+    // Waits at most timeout. Returns false, leaving out untouched, if no
+    // item arrived.
+    template <typename Rep, typename Period>
+    bool wait_dequeue(T& out, std::chrono::duration<Rep, Period> timeout) {
+        return wait_until_taken([&] { return try_dequeue(out); }, deadline_after(timeout));
+    }
+
+    // Waits until at least one item is available, then moves up to
+    // max_count to out. Returns how many.
+    template <std::output_iterator<T&&> Out>
+    std::size_t wait_dequeue_bulk(Out out, std::size_t max_count) {
+        std::size_t taken = 0;
+        wait_until_taken([&] { return (taken = try_dequeue_bulk(out, max_count)) != 0; }, std::nullopt);
+        return taken;
+    }
+
+    // As above, waiting at most timeout. Returns 0 if no item arrived.
+    template <std::output_iterator<T&&> Out, typename Rep, typename Period>
+    std::size_t wait_dequeue_bulk(Out out, std::size_t max_count, std::chrono::duration<Rep, Period> timeout) {
+        std::size_t taken = 0;
+        wait_until_taken([&] { return (taken = try_dequeue_bulk(out, max_count)) != 0; }, deadline_after(timeout));
+        return taken;
+    }
+
+private:
+    using Clock = EventCount::Clock;
+
+    // Empty checks a consumer makes on the atomic item count before it
+    // registers to sleep.
+    static constexpr int k_spin_checks = 64;
+
+    template <typename Rep, typename Period>
+    [[nodiscard]] static Clock::time_point deadline_after(std::chrono::duration<Rep, Period> timeout) {
+        return Clock::now() + std::chrono::ceil<Clock::duration>(timeout);
+    }
+
+    // Calls take() until it succeeds: first a few times in a row, then
+    // sleeping on events_ between attempts. take() is retried after
+    // prepare_wait(), so an item enqueued just before the consumer
+    // registered is not missed. Returns false if deadline passed first.
+    template <typename Take>
+    bool wait_until_taken(Take take, std::optional<Clock::time_point> deadline) {
+        for (int check = 0; check < k_spin_checks; ++check) {
+            if (size_.load(std::memory_order_relaxed) != 0 && take()) {
+                return true;
+            }
+        }
+
+        for (;;) {
+            if (take()) {
+                return true;
+            }
+
+            const EventCount::Key key = events_.prepare_wait();
+            if (take()) {
+                events_.cancel_wait();
+                return true;
+            }
+
+            if (!deadline) {
+                events_.wait(key);
+            } else if (!events_.wait_until(key, *deadline)) {
+                return take();
+            }
+        }
+    }
+
+    std::mutex mutex_;
+    RingQueue<T> items_;
+    // items_.size(), readable without the lock.
+    std::atomic<std::size_t> size_{0};
+    EventCount events_;
+};
+
+} // namespace exemplar
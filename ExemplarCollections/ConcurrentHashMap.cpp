@@ -0,0 +1,6 @@
+#include "ConcurrentHashMap.h"
+
+#include <string>
+
+template class exemplar::ConcurrentHashMap<int, int>;
+template class exemplar::ConcurrentHashMap<std::string, int>;
@@ -0,0 +1,205 @@
+#pragma once
+
+#include "HashMap.h"
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <thread>
+#include <utility>
+
+namespace exemplar {
+
+// A thread-safe hash map built from independent HashMap shards.
+// Each key maps to exactly one shard; each shard has its own reader-writer
+// lock and rehashes on its own, so writers to different shards never wait
+// on each other and one shard growing never stalls the rest.
+//
+// Values are returned by copy: handing out references would let callers
+// touch an entry after its shard lock has been released.
+template <typename K, typename V, typename Hash = std::hash<K>>
+class ConcurrentHashMap {
+public:
+    ConcurrentHashMap() : ConcurrentHashMap(default_shard_count()) {}
+
+    // shard_count is rounded up to a power of two.
+    explicit ConcurrentHashMap(std::size_t shard_count)
+        : shard_count_(std::bit_ceil(shard_count == 0 ? std::size_t{1} : shard_count)),
+          shard_shift_(64 - std::countr_zero(shard_count_)),
+          shards_(std::make_unique<Shard[]>(shard_count_)) {}
+
+    // Shards hold mutexes, which can be neither copied nor moved.
+    ConcurrentHashMap(const ConcurrentHashMap&) = delete;
+    ConcurrentHashMap& operator=(const ConcurrentHashMap&) = delete;
+
+    [[nodiscard]] std::size_t shard_count() const noexcept { return shard_count_; }
+
+    // Locks each shard in turn, so the result is only a snapshot
+    // when other threads are writing.
+    [[nodiscard]] std::size_t size() const {
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < shard_count_; ++i) {
+            std::shared_lock lock(shards_[i].mutex);
+            total += shards_[i].map.size();
+        }
+        return total;
+    }
+
+    [[nodiscard]] bool empty() const { return size() == 0; }
+
+    // Insert new key or update existing key.
+    // Returns true if inserted new key, false if updated existing key.
+    bool insert_or_assign(const K& key, const V& value) {
+        Shard& shard = shard_for(key);
+        std::unique_lock lock(shard.mutex);
+        return shard.map.insert_or_assign(key, value);
+    }
+
+    bool insert_or_assign(K&& key, V&& value) {
+        Shard& shard = shard_for(key);
+        std::unique_lock lock(shard.mutex);
+        return shard.map.insert_or_assign(std::move(key), std::move(value));
+    }
+
+    [[nodiscard]] bool contains(const K& key) const {
+        const Shard& shard = shard_for(key);
+        std::shared_lock lock(shard.mutex);
+        return shard.map.contains(key);
+    }
+
+    std::optional<V> get(const K& key) const {
+        const Shard& shard = shard_for(key);
+        std::shared_lock lock(shard.mutex);
+        return shard.map.get(key);
+    }
+
+    bool erase(const K& key) {
+        Shard& shard = shard_for(key);
+        std::unique_lock lock(shard.mutex);
+        return shard.map.erase(key);
+    }
+
+    // Heterogeneous lookups, enabled when Hash is transparent
+    // (see Transparent.h).
+    template <typename Q>
+        requires transparent<Hash>
+    [[nodiscard]] bool contains(const Q& key) const {
+        const Shard& shard = shard_for(key);
+        std::shared_lock lock(shard.mutex);
+        return shard.map.contains(key);
+    }
+
+    template <typename Q>
+        requires transparent<Hash>
+    std::optional<V> get(const Q& key) const {
+        const Shard& shard = shard_for(key);
+        std::shared_lock lock(shard.mutex);
+        return shard.map.get(key);
+    }
+
+    template <typename Q>
+        requires transparent<Hash>
+    bool erase(const Q& key) {
+        Shard& shard = shard_for(key);
+        std::unique_lock lock(shard.mutex);
+        return shard.map.erase(key);
+    }
+
+    // Atomically returns the existing value for key, or inserts and returns
+    // factory() if the key is missing. factory runs under the shard lock,
+    // so it is called at most once per missing key and must not touch this map.
+    template <typename Factory>
+    V compute_if_absent(const K& key, Factory&& factory) {
+        Shard& shard = shard_for(key);
+        std::unique_lock lock(shard.mutex);
+        if (std::optional<V> existing = shard.map.get(key)) {
+            return *std::move(existing);
+        }
+
+        V value = std::invoke(std::forward<Factory>(factory));
+        shard.map.insert_or_assign(key, value);
+        return value;
+    }
+
+    // Atomically applies fn(V&) to the value for key.
+    // Returns false (and does not call fn) if the key is missing.
+    // fn runs under the shard lock and must not touch this map.
+    template <typename Fn>
+    bool update(const K& key, Fn&& fn) {
+        Shard& shard = shard_for(key);
+        std::unique_lock lock(shard.mutex);
+        if (!shard.map.contains(key)) {
+            return false;
+        }
+
+        std::invoke(std::forward<Fn>(fn), shard.map.at(key));
+        return true;
+    }
+
+    // Atomically applies fn(V&) to the value for key, inserting V{} first
+    // if the key is missing (read-modify-write counterpart of operator[]).
+    template <typename Fn>
+    void upsert(const K& key, Fn&& fn) {
+        Shard& shard = shard_for(key);
+        std::unique_lock lock(shard.mutex);
+        std::invoke(std::forward<Fn>(fn), shard.map[key]);
+    }
+
+    void clear() {
+        for (std::size_t i = 0; i < shard_count_; ++i) {
+            std::unique_lock lock(shards_[i].mutex);
+            shards_[i].map.clear();
+        }
+    }
+
+private:
+    static constexpr std::size_t k_cache_line_size = 64;
+
+    // Each shard sits on its own cache line so that locking one shard does
+    // not invalidate the line holding a neighbouring shard's mutex.
+    struct alignas(k_cache_line_size) Shard {
+        mutable std::shared_mutex mutex;
+        HashMap<K, V, Hash> map;
+    };
+
+    // A few shards per hardware thread keeps the chance that two threads
+    // want the same shard low.
+    [[nodiscard]] static std::size_t default_shard_count() noexcept {
+        const std::size_t threads = std::thread::hardware_concurrency();
+        return std::bit_ceil((threads == 0 ? std::size_t{1} : threads) * 4);
+    }
+
+    // HashMap picks buckets from the low bits of the hash, so the shard is
+    // picked from the high bits of a mixed hash to keep the two independent.
+    template <typename Q>
+    [[nodiscard]] std::size_t shard_index(const Q& key) const {
+        if (shard_count_ == 1) {
+            return 0;
+        }
+
+        const std::uint64_t mixed = static_cast<std::uint64_t>(hasher_(key)) * 0x9E3779B97F4A7C15ULL;
+        return static_cast<std::size_t>(mixed >> shard_shift_);
+    }
+
+    template <typename Q>
+    [[nodiscard]] Shard& shard_for(const Q& key) {
+        return shards_[shard_index(key)];
+    }
+
+    template <typename Q>
+    [[nodiscard]] const Shard& shard_for(const Q& key) const {
+        return shards_[shard_index(key)];
+    }
+
+    std::size_t shard_count_;
+    int shard_shift_;
+    std::unique_ptr<Shard[]> shards_;
+    Hash hasher_{};
+};
+
+} // namespace exemplar
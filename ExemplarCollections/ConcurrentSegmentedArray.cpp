@@ -0,0 +1,6 @@
+#include "ConcurrentSegmentedArray.h"
+
+#include <string>
+
+template class exemplar::ConcurrentSegmentedArray<int>;
+template class exemplar::ConcurrentSegmentedArray<std::string>;
@@ -0,0 +1,279 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+namespace exemplar {
+
+// An append-only array that many threads can push to at once, without a
+// lock, while other threads read the elements already published.
+//
+// A writer claims the next index with one fetch_add, constructs its element
+// in that slot and then publishes it. Nothing else is shared between
+// writers, so appends do not queue up behind each other the way they do
+// behind a mutex around ResizingArray::push_back.
+//
+// Storage is SegmentedArray's fixed table of doubling blocks: growth
+// installs the next block with a compare-exchange and never moves an
+// element, so a published element stays at the same address for the
+// lifetime of the array and readers need no lock either.
+//
+// Elements are published one by one, not in index order: size() counts
+// claimed slots, some of which may still be under construction. Readers
+// index with a position they know is published (for example one handed to
+// them by the writer), check with try_get(), or walk the published prefix
+// with for_each_published().
+//
+// There is no erase or clear; the array is destroyed as a whole, after all
+// writers and readers are done with it.
+template <typename T>
+class ConcurrentSegmentedArray {
+public:
+    using value_type = T;
+
+    static constexpr std::size_t k_first_block_shift = 4;
+    static constexpr std::size_t k_first_block_size = std::size_t{1} << k_first_block_shift;
+
+    ConcurrentSegmentedArray() = default;
+
+    // Blocks are referred to by concurrent readers and writers.
+    ConcurrentSegmentedArray(const ConcurrentSegmentedArray&) = delete;
+    ConcurrentSegmentedArray& operator=(const ConcurrentSegmentedArray&) = delete;
+
+    ~ConcurrentSegmentedArray() {
+        for (std::size_t block = 0; block < k_block_count; ++block) {
+            T* elements = blocks_[block].load(std::memory_order_acquire);
+            if (elements == nullptr) {
+                continue;
+            }
+            std::atomic<std::uint8_t>* states = states_of(elements, block);
+            for (std::size_t offset = 0; offset < block_size(block); ++offset) {
+                if (states[offset].load(std::memory_order_relaxed) == k_published) {
+                    std::destroy_at(std::launder(elements + offset));
+                }
+            }
+            deallocate_block(elements, block);
+        }
+    }
+
+    // Slots claimed so far. A slot below size() may still be under
+    // construction; see is_published().
+    [[nodiscard]] std::size_t size() const noexcept { return claimed_.load(std::memory_order_acquire); }
+    [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+    // Elements the allocated blocks can hold.
+    [[nodiscard]] std::size_t capacity() const noexcept {
+        std::size_t block = 0;
+        while (block < k_block_count && blocks_[block].load(std::memory_order_acquire) != nullptr) {
+            ++block;
+        }
+        return capacity_before(block);
+    }
+
+    // Each element also needs its one-byte publication state.
+    [[nodiscard]] static constexpr std::size_t max_size() noexcept { return PTRDIFF_MAX / (sizeof(T) + 1); }
+
+    void push_back(const T& value) { emplace_back(value); }
+
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+
+    // Appends and returns the new element's index. Thread-safe. If the
+    // constructor throws, the slot stays claimed but is marked abandoned,
+    // and for_each_published() skips it.
+    //
+    // Once the slot's block exists, any later throw (including allocating
+    // the next block ahead of time) abandons the slot the same way. If the
+    // slot's own block cannot be allocated (std::bad_alloc, or
+    // std::length_error past max_size()), there is no state byte to mark:
+    // the slot stays empty, and for_each_published() stops at it for good.
+    template <typename... Args>
+    std::size_t emplace_back(Args&&... args) {
+        const std::size_t index = claimed_.fetch_add(1, std::memory_order_relaxed);
+        const Location location = locate(index);
+        std::atomic<std::uint8_t>* state = nullptr;
+        try {
+            if (index >= max_size()) {
+                throw std::length_error("ConcurrentSegmentedArray capacity exceeds max_size");
+            }
+            T* elements = install_block(location.block);
+            state = states_of(elements, location.block) + location.offset;
+            install_next_block(location);
+            std::construct_at(elements + location.offset, std::forward<Args>(args)...);
+        } catch (...) {
+            if (state != nullptr) {
+                state->store(k_abandoned, std::memory_order_release);
+            }
+            throw;
+        }
+        state->store(k_published, std::memory_order_release);
+        return index;
+    }
+
+    // Allocates the blocks for the first new_capacity elements up front, so
+    // writers do not race to allocate them later. Thread-safe.
+    void reserve(std::size_t new_capacity) {
+        if (new_capacity > max_size()) {
+            throw std::length_error("ConcurrentSegmentedArray capacity exceeds max_size");
+        }
+        for (std::size_t block = 0; capacity_before(block) < new_capacity; ++block) {
+            install_block(block);
+        }
+    }
+
+    // Whether the element at index has been constructed and is safe to read.
+    [[nodiscard]] bool is_published(std::size_t index) const noexcept { return try_get(index) != nullptr; }
+
+    // The element at index, or null if it is not published (yet).
+    [[nodiscard]] const T* try_get(std::size_t index) const noexcept {
+        if (index >= size()) {
+            return nullptr;
+        }
+
+        const Location location = locate(index);
+        T* elements = blocks_[location.block].load(std::memory_order_acquire);
+        if (elements == nullptr ||
+            states_of(elements, location.block)[location.offset].load(std::memory_order_acquire) != k_published) {
+            return nullptr;
+        }
+        return std::launder(elements + location.offset);
+    }
+
+    // index must be published: returned by emplace_back, or checked with
+    // try_get() by this thread or one that synchronized with it.
+    const T& operator[](std::size_t index) const noexcept {
+        const Location location = locate(index);
+        return *std::launder(blocks_[location.block].load(std::memory_order_acquire) + location.offset);
+    }
+
+    const T& at(std::size_t index) const {
+        const T* element = try_get(index);
+        if (element == nullptr) {
+            throw std::out_of_range("ConcurrentSegmentedArray::at index not published");
+        }
+        return *element;
+    }
+
+    // Calls visit(index, element) for each published element in index
+    // order, stopping at the first slot still under construction. Skips
+    // slots whose construction threw. Returns the index it stopped at, so a
+    // reader tailing the array can resume from there.
+    template <typename Visit>
+    std::size_t for_each_published(Visit&& visit, std::size_t first = 0) const {
+        const std::size_t last = size();
+        std::size_t index = first;
+        while (index < last) {
+            const Location location = locate(index);
+            T* elements = blocks_[location.block].load(std::memory_order_acquire);
+            if (elements == nullptr) {
+                break;
+            }
+
+            const std::atomic<std::uint8_t>* states = states_of(elements, location.block);
+            const std::size_t block_end = std::min(last, capacity_before(location.block + 1));
+            for (std::size_t offset = location.offset; index < block_end; ++index, ++offset) {
+                const std::uint8_t state = states[offset].load(std::memory_order_acquire);
+                if (state == k_empty) {
+                    return index;
+                }
+                if (state == k_published) {
+                    visit(index, *std::launder(elements + offset));
+                }
+            }
+        }
+        return index;
+    }
+
+private:
+    // Publication state of a slot, written once, with release, after the
+    // element is constructed (or its constructor threw).
+    static constexpr std::uint8_t k_empty = 0;
+    static constexpr std::uint8_t k_published = 1;
+    static constexpr std::uint8_t k_abandoned = 2;
+
+    // Enough blocks to reach max_size().
+    static constexpr std::size_t k_block_count = std::bit_width(max_size() / k_first_block_size) + 1;
+
+    struct Location {
+        std::size_t block;
+        std::size_t offset;
+    };
+
+    [[nodiscard]] static constexpr std::size_t block_size(std::size_t block) noexcept {
+        return k_first_block_size << block;
+    }
+
+    // Elements held by blocks [0, block).
+    [[nodiscard]] static constexpr std::size_t capacity_before(std::size_t block) noexcept {
+        return block_size(block) - k_first_block_size;
+    }
+
+    // Same mapping as SegmentedArray::locate.
+    [[nodiscard]] static constexpr Location locate(std::size_t index) noexcept {
+        const std::size_t biased = index + k_first_block_size;
+        const std::size_t block = static_cast<std::size_t>(std::bit_width(biased)) - 1 - k_first_block_shift;
+        return {block, biased - block_size(block)};
+    }
+
+    // A block is one allocation: uninitialized storage for its elements,
+    // then one state byte per element. Only the states are zeroed up
+    // front; an element's memory is first touched by the writer that fills
+    // it, and a record-sized T does not grow to fit a flag.
+    [[nodiscard]] static std::size_t block_bytes(std::size_t block) noexcept {
+        return block_size(block) * (sizeof(T) + 1);
+    }
+
+    [[nodiscard]] static std::atomic<std::uint8_t>* states_of(T* elements, std::size_t block) noexcept {
+        return reinterpret_cast<std::atomic<std::uint8_t>*>(elements + block_size(block));
+    }
+
+    [[nodiscard]] static T* allocate_block(std::size_t block) {
+        T* elements = static_cast<T*>(::operator new(block_bytes(block), std::align_val_t(alignof(T))));
+        std::uninitialized_value_construct_n(states_of(elements, block), block_size(block));
+        return elements;
+    }
+
+    static void deallocate_block(T* elements, std::size_t block) noexcept {
+        ::operator delete(elements, block_bytes(block), std::align_val_t(alignof(T)));
+    }
+
+    // The writer that claims the first slot of a block also installs the
+    // block after it, so that the next block is usually there before any
+    // writer reaches it and the race in install_block stays rare.
+    void install_next_block(const Location& location) {
+        if (location.offset == 0 && location.block + 1 < k_block_count) {
+            install_block(location.block + 1);
+        }
+    }
+
+    // Returns block, allocating it if nobody has yet. Writers that race to
+    // install the same block all allocate one; the compare-exchange picks
+    // a single winner and the others free theirs.
+    T* install_block(std::size_t block) {
+        T* elements = blocks_[block].load(std::memory_order_acquire);
+        if (elements != nullptr) {
+            return elements;
+        }
+
+        T* fresh = allocate_block(block);
+        if (blocks_[block].compare_exchange_strong(elements, fresh, std::memory_order_acq_rel,
+                                                   std::memory_order_acquire)) {
+            return fresh;
+        }
+        deallocate_block(fresh, block);
+        return elements;
+    }
+
+    // The claim counter and the block table are on separate cache lines:
+    // every append writes the counter, while the table is read-mostly.
+    alignas(64) std::atomic<std::size_t> claimed_{0};
+    alignas(64) std::atomic<T*> blocks_[k_block_count]{};
+};
+
+} // namespace exemplar
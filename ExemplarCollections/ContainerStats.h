@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+
+namespace exemplar {
+
+// Stats policies for ResizingArray and HashMap. A container calls the hooks
+// below where their names say, and returns its policy object from
+// stats(); reset_stats() starts the counts over.
+//
+// NoStats is the default. Its hooks are empty inline functions and the
+// containers store it with [[no_unique_address]], so an uninstrumented
+// container has the same size and code as before.
+//
+// Counters describe one container object: they are not copied, moved or
+// swapped along with its elements. A copy or move starts at zero, and the
+// target of an assignment keeps its own counts.
+struct NoStats {
+    // bytes were requested from the allocator.
+    void on_allocation(std::size_t /*bytes*/) noexcept {}
+
+    // Storage grew from old_capacity to new_capacity elements, and
+    // bytes_moved bytes of elements had to be moved or copied (zero when
+    // realloc or mremap grew the block in place).
+    void on_growth(std::size_t /*old_capacity*/, std::size_t /*new_capacity*/, std::size_t /*bytes_moved*/) noexcept {}
+
+    // A hash table grew from old_buckets to new_buckets buckets.
+    void on_rehash(std::size_t /*old_buckets*/, std::size_t /*new_buckets*/) noexcept {}
+
+    // A lookup or insert searched a bucket chain of chain_length entries.
+    void on_probe(std::size_t /*chain_length*/) noexcept {}
+};
+
+// Plain counters, for sizing containers from production traffic without a
+// profiler. They are not atomic: HashMap updates them from const lookups
+// too, so a CountingStats map must not be read from several threads at
+// once.
+struct CountingStats {
+    std::size_t allocations{0};
+    std::size_t bytes_allocated{0};
+    std::size_t growths{0};
+    std::size_t bytes_moved{0};
+    std::size_t rehashes{0};
+    std::size_t probes{0};
+    std::size_t probed_entries{0};
+    std::size_t longest_chain{0};
+
+    void on_allocation(std::size_t bytes) noexcept {
+        ++allocations;
+        bytes_allocated += bytes;
+    }
+
+    void on_growth(std::size_t /*old_capacity*/, std::size_t /*new_capacity*/, std::size_t moved) noexcept {
+        ++growths;
+        bytes_moved += moved;
+    }
+
+    void on_rehash(std::size_t /*old_buckets*/, std::size_t /*new_buckets*/) noexcept { ++rehashes; }
+
+    void on_probe(std::size_t chain_length) noexcept {
+        ++probes;
+        probed_entries += chain_length;
+        if (chain_length > longest_chain) {
+            longest_chain = chain_length;
+        }
+    }
+
+    // Average length of the chains that lookups and inserts searched.
+    [[nodiscard]] double mean_chain_length() const noexcept {
+        return probes == 0 ? 0.0 : static_cast<double>(probed_entries) / static_cast<double>(probes);
+    }
+};
+
+} // namespace exemplar
@@ -0,0 +1,6 @@
+#include "CowResizingArray.h"
+
+#include <string>
+
+template class exemplar::CowResizingArray<int>;
+template class exemplar::CowResizingArray<std::string>;
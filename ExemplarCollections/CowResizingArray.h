@@ -0,0 +1,296 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace exemplar {
+
+// A copy-on-write ResizingArray: copies share one reference-counted buffer,
+// so copying is O(1) regardless of size, and the elements are duplicated
+// only when a copy that shares them is first mutated.
+//
+// This makes snapshots cheap: a writer keeps mutating its array and hands
+// copies to readers, each of which sees the contents as of its copy.
+//
+// Thread safety matches std::shared_ptr: different CowResizingArray objects
+// may be copied, read, mutated and destroyed from different threads even
+// when they share a buffer, because the reference count is atomic and a
+// shared buffer is never written. A single object still needs external
+// synchronization if one thread mutates it while another uses it.
+//
+// Reads never detach, so element access is const-only. Writes go through
+// the mutators, set() or mutable_data(); a pointer from mutable_data() must
+// not be used after the array is next copied, or the write would show
+// through the copy.
+//
+// The object is a single pointer. The size, capacity and reference count
+// live in a header in front of the elements, in the same allocation.
+template <typename T>
+class CowResizingArray {
+    static_assert(std::is_copy_constructible_v<T>, "copy-on-write needs copyable elements");
+
+public:
+    using value_type = T;
+
+    CowResizingArray() noexcept = default;
+
+    explicit CowResizingArray(std::size_t initial_capacity) { reserve(initial_capacity); }
+
+    // O(1): shares other's buffer.
+    CowResizingArray(const CowResizingArray& other) noexcept : buffer_(other.buffer_) {
+        if (buffer_ != nullptr) {
+            buffer_->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    CowResizingArray& operator=(const CowResizingArray& other) noexcept {
+        CowResizingArray copy(other);
+        swap(copy);
+        return *this;
+    }
+
+    CowResizingArray(CowResizingArray&& other) noexcept : buffer_(std::exchange(other.buffer_, nullptr)) {}
+
+    CowResizingArray& operator=(CowResizingArray&& other) noexcept {
+        CowResizingArray moved(std::move(other));
+        swap(moved);
+        return *this;
+    }
+
+    ~CowResizingArray() { release(buffer_); }
+
+    [[nodiscard]] std::size_t size() const noexcept { return buffer_ != nullptr ? buffer_->size : 0; }
+    [[nodiscard]] std::size_t capacity() const noexcept { return buffer_ != nullptr ? buffer_->capacity : 0; }
+    [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+    [[nodiscard]] static constexpr std::size_t max_size() noexcept {
+        return (PTRDIFF_MAX - elements_offset()) / sizeof(T);
+    }
+
+    // Number of arrays sharing this buffer (0 without a buffer). Like
+    // shared_ptr::use_count, only a hint while other threads copy.
+    [[nodiscard]] std::size_t use_count() const noexcept {
+        return buffer_ != nullptr ? buffer_->refs.load(std::memory_order_relaxed) : 0;
+    }
+
+    // A hint as well; mutations decide with unique().
+    [[nodiscard]] bool is_shared() const noexcept { return use_count() > 1; }
+
+    [[nodiscard]] const T* data() const noexcept { return buffer_ != nullptr ? elements(buffer_) : nullptr; }
+
+    const T* begin() const noexcept { return data(); }
+    const T* end() const noexcept { return data() + size(); }
+
+    const T& operator[](std::size_t index) const noexcept { return elements(buffer_)[index]; }
+
+    const T& at(std::size_t index) const {
+        if (index >= size()) {
+            throw std::out_of_range("CowResizingArray::at index out of range");
+        }
+        return elements(buffer_)[index];
+    }
+
+    const T& front() const {
+        if (empty()) {
+            throw std::runtime_error("CowResizingArray::front on empty container");
+        }
+        return elements(buffer_)[0];
+    }
+
+    const T& back() const {
+        if (empty()) {
+            throw std::runtime_error("CowResizingArray::back on empty container");
+        }
+        return elements(buffer_)[size() - 1];
+    }
+
+    // Detaches, then gives write access to the elements. See the class
+    // comment for how long the pointer stays private to this array.
+    T* mutable_data() {
+        if (buffer_ == nullptr) {
+            return nullptr;
+        }
+        detach(capacity());
+        return elements(buffer_);
+    }
+
+    template <typename U = T>
+    void set(std::size_t index, U&& value) {
+        if (index >= size()) {
+            throw std::out_of_range("CowResizingArray::set index out of range");
+        }
+        detach(capacity());
+        elements(buffer_)[index] = std::forward<U>(value);
+    }
+
+    void push_back(const T& value) { emplace_back(value); }
+
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+
+    template <typename... Args>
+    T& emplace_back(Args&&... args) {
+        if (!unique() || buffer_->size == buffer_->capacity) {
+            // args may refer to an element of the buffer about to be
+            // replaced, so build the new element first.
+            T value(std::forward<Args>(args)...);
+            detach(size() == capacity() ? grown_capacity() : capacity());
+            return construct_back(std::move(value));
+        }
+        return construct_back(std::forward<Args>(args)...);
+    }
+
+    void pop_back() {
+        if (empty()) {
+            throw std::runtime_error("CowResizingArray::pop_back on empty container");
+        }
+        detach(capacity());
+        std::destroy_at(elements(buffer_) + --buffer_->size);
+    }
+
+    // A shared buffer is simply let go of; there is nothing to copy.
+    void clear() noexcept {
+        if (buffer_ == nullptr) {
+            return;
+        }
+
+        if (!unique()) {
+            release(std::exchange(buffer_, nullptr));
+            return;
+        }
+        std::destroy(elements(buffer_), elements(buffer_) + buffer_->size);
+        buffer_->size = 0;
+    }
+
+    void reserve(std::size_t new_capacity) {
+        if (new_capacity > capacity()) {
+            detach(new_capacity);
+        }
+    }
+
+    // Shrinks to new_size, or grows with value-initialized elements.
+    void resize(std::size_t new_size) {
+        const std::size_t old_size = size();
+        if (new_size == old_size) {
+            return;
+        }
+
+        detach(std::max(new_size, capacity()));
+        T* items = elements(buffer_);
+        if (new_size < old_size) {
+            std::destroy(items + new_size, items + old_size);
+        } else {
+            std::uninitialized_value_construct(items + old_size, items + new_size);
+        }
+        buffer_->size = new_size;
+    }
+
+    void swap(CowResizingArray& other) noexcept { std::swap(buffer_, other.buffer_); }
+
+private:
+    // Header placed in front of the elements. size and capacity are only
+    // written while the buffer is unshared.
+    struct Buffer {
+        std::atomic<std::size_t> refs{1};
+        std::size_t size{0};
+        std::size_t capacity{0};
+    };
+
+    [[nodiscard]] static constexpr std::size_t alignment() noexcept { return std::max(alignof(Buffer), alignof(T)); }
+
+    [[nodiscard]] static constexpr std::size_t elements_offset() noexcept {
+        return (sizeof(Buffer) + alignof(T) - 1) / alignof(T) * alignof(T);
+    }
+
+    [[nodiscard]] static T* elements(Buffer* buffer) noexcept {
+        return reinterpret_cast<T*>(reinterpret_cast<std::byte*>(buffer) + elements_offset());
+    }
+
+    [[nodiscard]] static Buffer* allocate(std::size_t capacity) {
+        if (capacity > max_size()) {
+            throw std::length_error("CowResizingArray capacity exceeds max_size");
+        }
+
+        void* memory = ::operator new(elements_offset() + capacity * sizeof(T), std::align_val_t(alignment()));
+        Buffer* buffer = ::new (memory) Buffer();
+        buffer->capacity = capacity;
+        return buffer;
+    }
+
+    static void deallocate(Buffer* buffer) noexcept {
+        buffer->~Buffer();
+        ::operator delete(buffer, std::align_val_t(alignment()));
+    }
+
+    // Drops one reference; the last one destroys the elements. acq_rel
+    // orders every other owner's reads of the elements before the
+    // destruction.
+    static void release(Buffer* buffer) noexcept {
+        if (buffer != nullptr && buffer->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            std::destroy(elements(buffer), elements(buffer) + buffer->size);
+            deallocate(buffer);
+        }
+    }
+
+    // Whether this array is the buffer's only owner, so its elements may be
+    // written, destroyed or moved from in place. The acquire pairs with
+    // other owners' fetch_sub in release(): once they have all let go,
+    // their reads of the elements happen before this thread's writes.
+    [[nodiscard]] bool unique() const noexcept {
+        return buffer_ != nullptr && buffer_->refs.load(std::memory_order_acquire) == 1;
+    }
+
+    [[nodiscard]] std::size_t grown_capacity() const noexcept { return capacity() == 0 ? 4 : capacity() * 2; }
+
+    // Makes buffer_ a buffer this array owns alone, with room for at least
+    // new_capacity >= size() elements. A no-op when that already holds;
+    // otherwise the elements are moved (sole owner) or copied (shared)
+    // into a new buffer. Strong guarantee.
+    void detach(std::size_t new_capacity) {
+        if (unique() && buffer_->capacity >= new_capacity) {
+            return;
+        }
+
+        Buffer* fresh = allocate(new_capacity);
+        if (buffer_ != nullptr) {
+            T* first = elements(buffer_);
+            T* last = first + buffer_->size;
+            try {
+                if (std::is_nothrow_move_constructible_v<T> && unique()) {
+                    std::uninitialized_move(first, last, elements(fresh));
+                } else {
+                    std::uninitialized_copy(first, last, elements(fresh));
+                }
+            } catch (...) {
+                deallocate(fresh);
+                throw;
+            }
+            fresh->size = buffer_->size;
+        }
+
+        release(std::exchange(buffer_, fresh));
+    }
+
+    // Constructs the new last element; the buffer is unshared with room.
+    template <typename... Args>
+    T& construct_back(Args&&... args) {
+        T* element = std::construct_at(elements(buffer_) + buffer_->size, std::forward<Args>(args)...);
+        ++buffer_->size;
+        return *element;
+    }
+
+    Buffer* buffer_{nullptr};
+};
+
+template <typename T>
+void swap(CowResizingArray<T>& left, CowResizingArray<T>& right) noexcept {
+    left.swap(right);
+}
+
+} // namespace exemplar
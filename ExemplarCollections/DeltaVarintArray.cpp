@@ -0,0 +1,216 @@
+#include "DeltaVarintArray.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+namespace exemplar {
+
+namespace {
+
+// Every value is stored as its difference from the one before; the first
+// of a block from the block's base value (itself, so that difference is
+// 0). A whole number of control bytes per block keeps the decoder free of
+// a partial final group.
+constexpr std::size_t k_deltas = DeltaVarintArray::k_block_size;
+constexpr std::size_t k_control_bytes = k_deltas / 4;
+static_assert(k_deltas % 4 == 0);
+
+// A varint is read with a 4-byte load, up to 3 bytes past its end.
+constexpr std::size_t k_read_padding = 3;
+
+constexpr std::uint32_t k_length_masks[4] = {0xFFu, 0xFFFFu, 0xFFFFFFu, 0xFFFFFFFFu};
+
+[[nodiscard]] std::uint32_t zigzag(std::uint32_t delta) noexcept {
+    return (delta << 1) ^ static_cast<std::uint32_t>(static_cast<std::int32_t>(delta) >> 31);
+}
+
+[[nodiscard]] std::uint32_t unzigzag(std::uint32_t code) noexcept {
+    return (code >> 1) ^ (0u - (code & 1));
+}
+
+[[nodiscard]] unsigned byte_length(std::uint32_t value) noexcept {
+    return 1 + (value > 0xFFu) + (value > 0xFFFFu) + (value > 0xFFFFFFu);
+}
+
+[[nodiscard]] std::uint32_t load_le32(const std::uint8_t* bytes) noexcept {
+    std::uint32_t word;
+    std::memcpy(&word, bytes, sizeof(word));
+    if constexpr (std::endian::native == std::endian::big) {
+        word = std::byteswap(word);
+    }
+    return word;
+}
+
+// Byte offsets of the four varints described by one control byte, and
+// their total length. With these, the read pointer advances once per four
+// varints instead of after each one.
+struct ControlTable {
+    std::uint8_t offsets[256][4];
+    std::uint8_t lengths[256];
+};
+
+constexpr ControlTable make_control_table() {
+    ControlTable table{};
+    for (unsigned control = 0; control < 256; ++control) {
+        unsigned offset = 0;
+        for (unsigned i = 0; i < 4; ++i) {
+            table.offsets[control][i] = static_cast<std::uint8_t>(offset);
+            offset += ((control >> (2 * i)) & 3u) + 1;
+        }
+        table.lengths[control] = static_cast<std::uint8_t>(offset);
+    }
+    return table;
+}
+
+constexpr ControlTable k_control_table = make_control_table();
+
+// Decodes one sealed block's differences, four per control byte. The loop
+// body is branch-free: the control byte only selects offsets and masks.
+template <bool Zigzag>
+void decode_deltas(const std::uint8_t* control, std::uint32_t base, std::uint32_t* out) noexcept {
+    const std::uint8_t* data = control + k_control_bytes;
+    std::uint32_t value = base;
+    for (std::size_t group = 0; group < k_control_bytes; ++group) {
+        const unsigned byte = control[group];
+        const std::uint8_t* offsets = k_control_table.offsets[byte];
+        for (unsigned i = 0; i < 4; ++i) {
+            std::uint32_t delta = load_le32(data + offsets[i]) & k_length_masks[(byte >> (2 * i)) & 3u];
+            if constexpr (Zigzag) {
+                delta = unzigzag(delta);
+            }
+            value += delta;
+            out[4 * group + i] = value;
+        }
+        data += k_control_table.lengths[byte];
+    }
+}
+
+} // namespace
+
+DeltaVarintArray::DeltaVarintArray(DeltaVarintArray&& other) noexcept
+    : blocks_(std::move(other.blocks_)),
+      bytes_(std::move(other.bytes_)),
+      tail_(other.tail_),
+      size_(std::exchange(other.size_, 0)) {}
+
+DeltaVarintArray& DeltaVarintArray::operator=(DeltaVarintArray&& other) noexcept {
+    if (this != &other) {
+        blocks_ = std::move(other.blocks_);
+        bytes_ = std::move(other.bytes_);
+        tail_ = other.tail_;
+        size_ = std::exchange(other.size_, 0);
+    }
+    return *this;
+}
+
+std::size_t DeltaVarintArray::memory_bytes() const noexcept {
+    return blocks_.capacity() * sizeof(Block) + bytes_.capacity() + sizeof(tail_);
+}
+
+void DeltaVarintArray::push_back(std::uint32_t value) {
+    tail_[size_ % k_block_size] = value;
+    // Count the value only once its block is sealed: if sealing throws, the
+    // tail is still whole and the array still holds size_ values.
+    if ((size_ + 1) % k_block_size == 0) {
+        seal_tail();
+    }
+    ++size_;
+}
+
+std::uint32_t DeltaVarintArray::at(std::size_t index) const {
+    if (index >= size_) {
+        throw std::out_of_range("DeltaVarintArray::at index out of range");
+    }
+
+    std::array<std::uint32_t, k_block_size> buffer;
+    decode_block(index / k_block_size, buffer);
+    return buffer[index % k_block_size];
+}
+
+std::size_t DeltaVarintArray::decode_block(std::size_t block, std::span<std::uint32_t, k_block_size> out) const {
+    if (block >= block_count()) {
+        throw std::out_of_range("DeltaVarintArray::decode_block block out of range");
+    }
+
+    if (block < blocks_.size()) {
+        decode_sealed(block, out.data());
+        return k_block_size;
+    }
+
+    const std::size_t count = size_ % k_block_size;
+    std::copy_n(tail_.begin(), count, out.begin());
+    return count;
+}
+
+void DeltaVarintArray::decode(ResizingArray<std::uint32_t>& out) const {
+    out.resize_uninitialized(size_);
+    std::uint32_t* values = out.data();
+    for (std::size_t block = 0; block < blocks_.size(); ++block) {
+        decode_sealed(block, values + block * k_block_size);
+    }
+    std::copy_n(tail_.begin(), size_ % k_block_size, values + blocks_.size() * k_block_size);
+}
+
+void DeltaVarintArray::clear() noexcept {
+    blocks_.clear();
+    bytes_.clear();
+    size_ = 0;
+}
+
+// Encodes the full tail_ as a new block at the end of bytes_.
+void DeltaVarintArray::seal_tail() {
+    std::uint32_t deltas[k_deltas];
+    deltas[0] = 0;
+    bool decreasing = false;
+    for (std::size_t i = 1; i < k_deltas; ++i) {
+        deltas[i] = tail_[i] - tail_[i - 1];
+        decreasing |= tail_[i] < tail_[i - 1];
+    }
+    if (decreasing) {
+        for (std::uint32_t& delta : deltas) {
+            delta = zigzag(delta);
+        }
+    }
+
+    std::uint8_t encoded[k_control_bytes + 4 * k_deltas] = {};
+    std::uint8_t* data = encoded + k_control_bytes;
+    for (std::size_t i = 0; i < k_deltas; ++i) {
+        const unsigned length = byte_length(deltas[i]);
+        encoded[i / 4] |= static_cast<std::uint8_t>((length - 1) << (2 * (i % 4)));
+        for (unsigned byte = 0; byte < length; ++byte) {
+            *data++ = static_cast<std::uint8_t>(deltas[i] >> (8 * byte));
+        }
+    }
+
+    // The padding of the previous block becomes the start of this one.
+    const std::size_t offset = bytes_.size() < k_read_padding ? 0 : bytes_.size() - k_read_padding;
+    const auto length = static_cast<std::size_t>(data - encoded);
+    const std::size_t old_size = bytes_.size();
+    bytes_.resize_uninitialized(offset + length + k_read_padding);
+    std::memcpy(bytes_.data() + offset, encoded, length);
+    std::memset(bytes_.data() + offset + length, 0, k_read_padding);
+
+    // The header goes in last, so no header ever points past bytes_.
+    // Shrinking bytes_ back does not allocate.
+    try {
+        blocks_.push_back(Block{offset, tail_[0], decreasing});
+    } catch (...) {
+        bytes_.resize_uninitialized(old_size);
+        throw;
+    }
+}
+
+void DeltaVarintArray::decode_sealed(std::size_t block, std::uint32_t* out) const noexcept {
+    const Block& header = blocks_[block];
+    const std::uint8_t* control = bytes_.data() + header.offset;
+    if (header.zigzag) {
+        decode_deltas<true>(control, header.base, out);
+    } else {
+        decode_deltas<false>(control, header.base, out);
+    }
+}
+
+} // namespace exemplar
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "ResizingArray.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace exemplar {
+
+// An append-only array of 32-bit unsigned integers compressed in blocks of
+// k_block_size: each block keeps its first value as a base and the
+// differences between neighbours as 1-4 byte varints. Sorted or clustered IDs have
+// small differences, so most take one or two bytes instead of four.
+//
+// Blocks use the Stream VByte layout: the 2-bit lengths of all varints come
+// first, packed four per control byte, followed by the data bytes. Decoding
+// then needs no per-byte continuation test; every varint is one unaligned
+// 4-byte load and a mask, with no data-dependent branch, and the same layout
+// is what SIMD shuffle decoders consume. A block whose values ever decrease
+// zigzag-encodes its differences, so unsorted input still round-trips.
+//
+// Access is sequential: for_each and decode unpack a block at a time. at()
+// works, but decodes the whole block to read one value. For O(1) random
+// access use PackedIntArray.
+class DeltaVarintArray {
+public:
+    using value_type = std::uint32_t;
+
+    static constexpr std::size_t k_block_size = 128;
+
+    DeltaVarintArray() = default;
+    DeltaVarintArray(const DeltaVarintArray&) = default;
+    DeltaVarintArray& operator=(const DeltaVarintArray&) = default;
+
+    // Leave other empty, as after clear().
+    DeltaVarintArray(DeltaVarintArray&& other) noexcept;
+    DeltaVarintArray& operator=(DeltaVarintArray&& other) noexcept;
+
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+    [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+
+    // Blocks, counting a final partial one.
+    [[nodiscard]] std::size_t block_count() const noexcept { return (size_ + k_block_size - 1) / k_block_size; }
+
+    // Bytes allocated for encoded blocks, block headers and the unencoded
+    // tail, including spare capacity.
+    [[nodiscard]] std::size_t memory_bytes() const noexcept;
+
+    void push_back(std::uint32_t value);
+
+    // O(k_block_size).
+    [[nodiscard]] std::uint32_t at(std::size_t index) const;
+
+    // Writes block's values to out and returns how many there are
+    // (k_block_size for every block but possibly the last).
+    std::size_t decode_block(std::size_t block, std::span<std::uint32_t, k_block_size> out) const;
+
+    // Replaces out's contents with every value, in order.
+    void decode(ResizingArray<std::uint32_t>& out) const;
+
+    // Calls fn(value) for every value, in order.
+    template <typename Fn>
+    void for_each(Fn&& fn) const {
+        std::array<std::uint32_t, k_block_size> buffer;
+        for (std::size_t block = 0; block < block_count(); ++block) {
+            const std::size_t count = decode_block(block, buffer);
+            for (std::size_t i = 0; i < count; ++i) {
+                fn(buffer[i]);
+            }
+        }
+    }
+
+    void clear() noexcept;
+
+private:
+    struct Block {
+        std::uint64_t offset;
+        std::uint32_t base;
+        bool zigzag;
+    };
+
+    void seal_tail();
+    void decode_sealed(std::size_t block, std::uint32_t* out) const noexcept;
+
+    ResizingArray<Block> blocks_;
+
+    // Encoded blocks back to back, followed by padding so that the last
+    // varint's 4-byte load stays inside the array.
+    ResizingArray<std::uint8_t> bytes_;
+
+    // Values of the block being filled, not yet encoded.
+    std::array<std::uint32_t, k_block_size> tail_{};
+    std::size_t size_{0};
+};
+
+} // namespace exemplar
@@ -1,6 +1,8 @@
 #include "DoublyLinkedList.h"
 
+#include <memory_resource>
 #include <string>
 
 template class exemplar::DoublyLinkedList<int>;
 template class exemplar::DoublyLinkedList<std::string>;
+template class exemplar::DoublyLinkedList<std::pmr::string, std::pmr::polymorphic_allocator<std::pmr::string>>;
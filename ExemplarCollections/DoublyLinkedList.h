@@ -1,6 +1,10 @@
 #pragma once
 
+#include "AllocatorSupport.h"
+
 #include <cstddef>
+#include <memory>
+#include <memory_resource>
 #include <stdexcept>
 #include <utility>
 
@@ -9,14 +13,30 @@ namespace exemplar {
 // A minimal doubly linked list with head/tail pointers.
 // We use raw pointers for educational visibility of node linkage.
 // Resource cleanup is centralized in clear()/destructor.
-template <typename T>
+//
+// Nodes come from Allocator (rebound to the node type); with a std::pmr
+// allocator the elements are constructed with it too.
+template <typename T, typename Allocator = std::allocator<T>>
 class DoublyLinkedList {
 public:
+    using allocator_type = Allocator;
+
     DoublyLinkedList() = default;
 
-    DoublyLinkedList(const DoublyLinkedList& other) {
-        for (Node* cursor = other.head_; cursor != nullptr; cursor = cursor->next) {
-            push_back(cursor->value);
+    explicit DoublyLinkedList(const Allocator& alloc) noexcept : node_alloc_(alloc) {}
+
+    DoublyLinkedList(const DoublyLinkedList& other)
+        : DoublyLinkedList(other,
+                           std::allocator_traits<Allocator>::select_on_container_copy_construction(other.get_allocator())) {}
+
+    DoublyLinkedList(const DoublyLinkedList& other, const Allocator& alloc) : node_alloc_(alloc) {
+        try {
+            for (Node* cursor = other.head_; cursor != nullptr; cursor = cursor->next) {
+                push_back(cursor->value);
+            }
+        } catch (...) {
+            clear();
+            throw;
         }
     }
 
@@ -25,44 +45,67 @@ public:
             return *this;
         }
 
-        DoublyLinkedList copy(other);
-        swap(copy);
+        DoublyLinkedList copy(other, detail::propagate_on_copy_assignment_v<Allocator> ? other.get_allocator()
+                                                                                        : get_allocator());
+        if constexpr (detail::propagate_on_copy_assignment_v<Allocator>) {
+            std::swap(node_alloc_, copy.node_alloc_);
+        }
+        swap_nodes(copy);
         return *this;
     }
 
-    DoublyLinkedList(DoublyLinkedList&& other) noexcept
-        : head_(other.head_), tail_(other.tail_), size_(other.size_) {
-        other.head_ = nullptr;
-        other.tail_ = nullptr;
-        other.size_ = 0;
+    DoublyLinkedList(DoublyLinkedList&& other) noexcept : node_alloc_(std::move(other.node_alloc_)) {
+        swap_nodes(other);
     }
 
-    DoublyLinkedList& operator=(DoublyLinkedList&& other) noexcept {
-        if (this == &other) {
-            return *this;
+    // Moves element by element when alloc cannot free other's nodes.
+    DoublyLinkedList(DoublyLinkedList&& other, const Allocator& alloc) : node_alloc_(alloc) {
+        if (node_alloc_ == other.node_alloc_) {
+            swap_nodes(other);
+            return;
         }
 
-        clear();
-        head_ = other.head_;
-        tail_ = other.tail_;
-        size_ = other.size_;
+        try {
+            for (Node* cursor = other.head_; cursor != nullptr; cursor = cursor->next) {
+                push_back(std::move(cursor->value));
+            }
+        } catch (...) {
+            clear();
+            throw;
+        }
+    }
 
-        other.head_ = nullptr;
-        other.tail_ = nullptr;
-        other.size_ = 0;
+    DoublyLinkedList& operator=(DoublyLinkedList&& other) noexcept(detail::nothrow_move_assignable_v<Allocator>) {
+        if (this == &other) {
+            return *this;
+        }
 
+        if constexpr (detail::propagate_on_move_assignment_v<Allocator>) {
+            clear();
+            node_alloc_ = std::move(other.node_alloc_);
+            swap_nodes(other);
+        } else if (node_alloc_ == other.node_alloc_) {
+            clear();
+            swap_nodes(other);
+        } else {
+            DoublyLinkedList moved(std::move(other), get_allocator());
+            clear();
+            swap_nodes(moved);
+        }
         return *this;
     }
 
     ~DoublyLinkedList() { clear(); }
 
+    [[nodiscard]] allocator_type get_allocator() const noexcept { return allocator_type(node_alloc_); }
+
     [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
     [[nodiscard]] std::size_t size() const noexcept { return size_; }
 
-    void push_front(const T& value) { link_front(new Node(value)); }
-    void push_front(T&& value) { link_front(new Node(std::move(value))); }
-    void push_back(const T& value) { link_back(new Node(value)); }
-    void push_back(T&& value) { link_back(new Node(std::move(value))); }
+    void push_front(const T& value) { link_front(detail::new_node(node_alloc_, get_allocator(), value)); }
+    void push_front(T&& value) { link_front(detail::new_node(node_alloc_, get_allocator(), std::move(value))); }
+    void push_back(const T& value) { link_back(detail::new_node(node_alloc_, get_allocator(), value)); }
+    void push_back(T&& value) { link_back(detail::new_node(node_alloc_, get_allocator(), std::move(value))); }
 
     void pop_front() {
         if (empty()) {
@@ -71,14 +114,13 @@ public:
 
         Node* old_head = head_;
         head_ = head_->next;
-
         if (head_ != nullptr) {
             head_->prev = nullptr;
         } else {
             tail_ = nullptr;
         }
 
-        delete old_head;
+        detail::delete_node(node_alloc_, old_head);
         --size_;
     }
 
@@ -89,14 +131,13 @@ public:
 
         Node* old_tail = tail_;
         tail_ = tail_->prev;
-
         if (tail_ != nullptr) {
             tail_->next = nullptr;
         } else {
             head_ = nullptr;
         }
 
-        delete old_tail;
+        detail::delete_node(node_alloc_, old_tail);
         --size_;
     }
 
@@ -132,7 +173,7 @@ public:
         Node* cursor = head_;
         while (cursor != nullptr) {
             Node* next = cursor->next;
-            delete cursor;
+            detail::delete_node(node_alloc_, cursor);
             cursor = next;
         }
 
@@ -141,22 +182,28 @@ public:
         size_ = 0;
     }
 
+    // As with the std containers, swapping lists whose allocators differ
+    // and do not propagate on swap is undefined.
     void swap(DoublyLinkedList& other) noexcept {
-        std::swap(head_, other.head_);
-        std::swap(tail_, other.tail_);
-        std::swap(size_, other.size_);
+        if constexpr (detail::propagate_on_swap_v<Allocator>) {
+            std::swap(node_alloc_, other.node_alloc_);
+        }
+        swap_nodes(other);
     }
 
 private:
     struct Node {
-        explicit Node(const T& v) : value(v) {}
-        explicit Node(T&& v) : value(std::move(v)) {}
+        template <typename... Args>
+        explicit Node(const Allocator& alloc, Args&&... args)
+            : value(std::make_obj_using_allocator<T>(alloc, std::forward<Args>(args)...)) {}
 
         T value;
         Node* prev{nullptr};
         Node* next{nullptr};
     };
 
+    using NodeAllocator = detail::rebind_alloc_t<Allocator, Node>;
+
     void link_front(Node* node) {
         node->next = head_;
         if (head_ != nullptr) {
@@ -181,14 +228,28 @@ private:
         ++size_;
     }
 
+    void swap_nodes(DoublyLinkedList& other) noexcept {
+        std::swap(head_, other.head_);
+        std::swap(tail_, other.tail_);
+        std::swap(size_, other.size_);
+    }
+
+    [[no_unique_address]] NodeAllocator node_alloc_{};
     Node* head_{nullptr};
     Node* tail_{nullptr};
     std::size_t size_{0};
 };
 
-template <typename T>
-void swap(DoublyLinkedList<T>& left, DoublyLinkedList<T>& right) noexcept {
+template <typename T, typename Allocator>
+void swap(DoublyLinkedList<T, Allocator>& left, DoublyLinkedList<T, Allocator>& right) noexcept {
     left.swap(right);
 }
 
+namespace pmr {
+
+template <typename T>
+using DoublyLinkedList = exemplar::DoublyLinkedList<T, std::pmr::polymorphic_allocator<T>>;
+
+} // namespace pmr
+
 } // namespace exemplar
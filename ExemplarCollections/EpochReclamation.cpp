@@ -0,0 +1,122 @@
+#include "EpochReclamation.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace exemplar {
+
+namespace {
+
+// Per-thread registration in the global domain. Releasing the slot at thread
+// exit lets a later thread reuse it.
+struct ThreadRegistration {
+    std::atomic<bool>* claimed{nullptr};
+    void* slot{nullptr};
+    std::size_t depth{0};
+
+    ~ThreadRegistration() {
+        if (claimed != nullptr) {
+            claimed->store(false, std::memory_order_release);
+        }
+    }
+};
+
+thread_local ThreadRegistration t_registration;
+
+} // namespace
+
+EpochDomain& EpochDomain::global() {
+    static EpochDomain domain;
+    return domain;
+}
+
+EpochDomain::~EpochDomain() {
+    for (auto& retired : retired_) {
+        retired.deleter();
+    }
+}
+
+EpochDomain::ReaderSlot& EpochDomain::slot_for_this_thread() {
+    if (t_registration.slot != nullptr) {
+        return *static_cast<ReaderSlot*>(t_registration.slot);
+    }
+
+    for (auto& slot : slots_) {
+        bool expected = false;
+        if (!slot.claimed.load(std::memory_order_relaxed) &&
+            slot.claimed.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+            t_registration.claimed = &slot.claimed;
+            t_registration.slot = &slot;
+            return slot;
+        }
+    }
+
+    throw std::runtime_error("EpochDomain has no free reader slots");
+}
+
+std::uint64_t EpochDomain::oldest_active_epoch() const noexcept {
+    std::uint64_t oldest = std::numeric_limits<std::uint64_t>::max();
+    for (const auto& slot : slots_) {
+        const std::uint64_t epoch = slot.epoch.load(std::memory_order_seq_cst);
+        if (epoch != 0) {
+            oldest = std::min(oldest, epoch);
+        }
+    }
+    return oldest;
+}
+
+void EpochDomain::retire(std::function<void()> deleter) {
+    std::lock_guard lock(retired_mutex_);
+
+    // Readers that announced an epoch <= this one may have loaded the object
+    // before it was unlinked. Advancing the epoch means every later reader
+    // announces a larger value.
+    retired_.push_back(Retired{epoch_.fetch_add(1, std::memory_order_seq_cst), std::move(deleter)});
+    reclaim_locked();
+}
+
+std::size_t EpochDomain::try_reclaim() {
+    std::lock_guard lock(retired_mutex_);
+    return reclaim_locked();
+}
+
+std::size_t EpochDomain::reclaim_locked() {
+    const std::uint64_t oldest = oldest_active_epoch();
+
+    std::vector<Retired> still_visible;
+    for (auto& retired : retired_) {
+        if (retired.epoch < oldest) {
+            retired.deleter();
+        } else {
+            still_visible.push_back(std::move(retired));
+        }
+    }
+
+    retired_ = std::move(still_visible);
+    return retired_.size();
+}
+
+EpochGuard::EpochGuard() {
+    if (t_registration.depth != 0) {
+        ++t_registration.depth;
+        return;
+    }
+
+    EpochDomain& domain = EpochDomain::global();
+    slot_ = &domain.slot_for_this_thread();
+    ++t_registration.depth;
+    // seq_cst store, then the caller's loads: a writer that scans slots after
+    // unlinking either sees this announcement or this reader sees the unlink.
+    slot_->epoch.store(domain.epoch_.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+}
+
+EpochGuard::~EpochGuard() {
+    --t_registration.depth;
+    if (slot_ != nullptr) {
+        slot_->epoch.store(0, std::memory_order_release);
+    }
+}
+
+} // namespace exemplar
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace exemplar {
+
+// Epoch-based reclamation (EBR), implemented with plain atomics.
+//
+// Readers bracket their accesses with an EpochGuard, which records the
+// current global epoch in a slot owned by the reading thread. A writer that
+// unlinks an object calls retire(); the object is freed only once every
+// thread that was reading at the time has left its guard, which is detected
+// by scanning the reader slots.
+//
+// Readers never take a lock and only write to their own cache line.
+// One process-wide domain is shared by every user; see EpochDomain::global().
+class EpochDomain {
+public:
+    // Upper bound on threads that are registered as readers at the same time.
+    // A thread registers on its first EpochGuard and unregisters at exit.
+    static constexpr std::size_t k_max_reader_threads = 512;
+
+    static EpochDomain& global();
+
+    EpochDomain(const EpochDomain&) = delete;
+    EpochDomain& operator=(const EpochDomain&) = delete;
+
+    // Runs every deleter still pending. The global domain is destroyed at
+    // exit, after the last reader has gone.
+    ~EpochDomain();
+
+    // Defers deleter() until no reader can still see the retired object.
+    // Called by writers; safe to call from several threads.
+    void retire(std::function<void()> deleter);
+
+    // Frees whatever retired objects are no longer visible to any reader.
+    // Returns the number of objects still waiting.
+    std::size_t try_reclaim();
+
+private:
+    friend class EpochGuard;
+
+    EpochDomain() = default;
+
+    struct alignas(64) ReaderSlot {
+        // 0 while the owning thread is outside any guard.
+        std::atomic<std::uint64_t> epoch{0};
+        std::atomic<bool> claimed{false};
+    };
+
+    struct Retired {
+        std::uint64_t epoch;
+        std::function<void()> deleter;
+    };
+
+    ReaderSlot& slot_for_this_thread();
+    [[nodiscard]] std::uint64_t oldest_active_epoch() const noexcept;
+    std::size_t reclaim_locked();
+
+    // Starts at 1 so that 0 can mean "not reading".
+    alignas(64) std::atomic<std::uint64_t> epoch_{1};
+    ReaderSlot slots_[k_max_reader_threads];
+
+    std::mutex retired_mutex_;
+    std::vector<Retired> retired_;
+};
+
+// RAII read-side critical section. Pointers loaded from an EBR-protected
+// structure stay valid until the guard is destroyed. Guards may nest.
+class EpochGuard {
+public:
+    EpochGuard();
+
+    EpochGuard(const EpochGuard&) = delete;
+    EpochGuard& operator=(const EpochGuard&) = delete;
+
+    ~EpochGuard();
+
+private:
+    EpochDomain::ReaderSlot* slot_{nullptr};
+};
+
+} // namespace exemplar
@@ -0,0 +1,141 @@
+#include "EventCount.h"
+
+#include <algorithm>
+#include <climits>
+#include <thread>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <ctime>
+#endif
+
+namespace exemplar {
+
+namespace {
+
+#if defined(__linux__)
+
+static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t) &&
+                  std::atomic<std::uint32_t>::is_always_lock_free,
+              "the futex word must be a plain 32-bit integer");
+
+std::uint32_t* futex_word(std::atomic<std::uint32_t>& word) noexcept {
+    return reinterpret_cast<std::uint32_t*>(&word);
+}
+
+// Sleeps while word still holds expected, for at most timeout (null: no
+// limit). Returns on a wake, a timeout, a signal or a changed word alike.
+void futex_wait(std::atomic<std::uint32_t>& word, std::uint32_t expected, const timespec* timeout) noexcept {
+    ::syscall(SYS_futex, futex_word(word), FUTEX_WAIT_PRIVATE, expected, timeout, nullptr, 0);
+}
+
+void futex_wake(std::atomic<std::uint32_t>& word, int count) noexcept {
+    ::syscall(SYS_futex, futex_word(word), FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0);
+}
+
+#endif
+
+} // namespace
+
+EventCount::Key EventCount::prepare_wait() noexcept {
+    state_.fetch_add(k_one_waiter, std::memory_order_relaxed);
+    // Pairs with the fence in notify(): either the notifier sees this
+    // waiter, or this thread's recheck of its condition (even with relaxed
+    // loads) sees what the notifier published before notifying.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    // acquire: if this already reads a notifier's bump, the recheck sees
+    // what that notifier published.
+    return epoch_.load(std::memory_order_acquire);
+}
+
+void EventCount::cancel_wait() noexcept { leave(); }
+
+void EventCount::wait(Key key) noexcept {
+#if defined(__linux__)
+    while (epoch_.load(std::memory_order_acquire) == key) {
+        futex_wait(epoch_, key, nullptr);
+    }
+#else
+    epoch_.wait(key, std::memory_order_acquire);
+#endif
+    leave();
+}
+
+bool EventCount::wait_until(Key key, Clock::time_point deadline) noexcept {
+    bool woken = true;
+#if defined(__linux__)
+    while (epoch_.load(std::memory_order_acquire) == key) {
+        const auto remaining = deadline - Clock::now();
+        if (remaining <= Clock::duration::zero()) {
+            woken = false;
+            break;
+        }
+        const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(remaining);
+        const timespec timeout{static_cast<std::time_t>(seconds.count()),
+                               static_cast<long>(std::chrono::nanoseconds(remaining - seconds).count())};
+        futex_wait(epoch_, key, &timeout);
+    }
+#else
+    auto pause = std::chrono::microseconds(1);
+    while (epoch_.load(std::memory_order_acquire) == key) {
+        if (Clock::now() >= deadline) {
+            woken = false;
+            break;
+        }
+        std::this_thread::sleep_for(pause);
+        pause = std::min(pause * 2, std::chrono::microseconds(1000));
+    }
+#endif
+    leave();
+    return woken;
+}
+
+void EventCount::leave() noexcept {
+    std::uint64_t state = state_.load(std::memory_order_relaxed);
+    for (;;) {
+        const std::uint64_t next = state - k_one_waiter - (signals(state) != 0 ? k_one_signal : 0);
+        if (state_.compare_exchange_weak(state, next, std::memory_order_relaxed)) {
+            break;
+        }
+    }
+    // Pairs with the fence in notify(): a notify that found this thread
+    // still registered (and so skipped its wake) published its update
+    // before that fence, and the caller's recheck after this one sees it.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+void EventCount::notify(bool all) noexcept {
+    // Pairs with the fences in prepare_wait() and leave(); without them the
+    // waiter's recheck and the load below could each miss the other side.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    std::uint64_t state = state_.load(std::memory_order_relaxed);
+    for (;;) {
+        // Every registered waiter already has a wake on its way, and will
+        // recheck its condition when it leaves.
+        if (signals(state) >= waiters(state)) {
+            return;
+        }
+        const std::uint64_t signalled = all ? waiters(state) : signals(state) + 1;
+        const std::uint64_t next = waiters(state) | (signalled << k_signal_shift);
+        if (state_.compare_exchange_weak(state, next, std::memory_order_relaxed)) {
+            break;
+        }
+    }
+
+    epoch_.fetch_add(1, std::memory_order_release);
+#if defined(__linux__)
+    futex_wake(epoch_, all ? INT_MAX : 1);
+#else
+    if (all) {
+        epoch_.notify_all();
+    } else {
+        epoch_.notify_one();
+    }
+#endif
+}
+
+} // namespace exemplar
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace exemplar {
+
+// Lets threads sleep until "something changed" without a mutex, and makes
+// notifying free when nobody is asleep. The building block for blocking
+// queues on top of non-blocking ones.
+//
+// A waiter announces itself, rechecks its condition, and only then sleeps:
+//
+//     while (!try_take(item)) {
+//         const EventCount::Key key = events.prepare_wait();
+//         if (try_take(item)) {
+//             events.cancel_wait();
+//             break;
+//         }
+//         events.wait(key);
+//     }
+//
+// A notifier first makes the condition true (publishes the item) and then
+// calls notify_one() or notify_all(). Those return without a syscall unless
+// some registered waiter has not been signalled yet; otherwise they bump an
+// epoch and wake a sleeper. A notify that lands between prepare_wait() and
+// wait() bumps the epoch, so the wait returns at once instead of missing
+// the wakeup. A burst of notifies while a woken waiter is still on its way
+// costs one syscall, not one each: the waiter rechecks its condition when
+// it leaves, so it picks up what the skipped notifies published.
+//
+// On Linux the sleep is a futex on the epoch word, with a timeout for
+// wait_until(). Elsewhere wait() uses std::atomic::wait and wait_until()
+// polls the epoch with a capped exponential backoff.
+class EventCount {
+public:
+    using Key = std::uint32_t;
+    using Clock = std::chrono::steady_clock;
+
+    EventCount() = default;
+
+    EventCount(const EventCount&) = delete;
+    EventCount& operator=(const EventCount&) = delete;
+
+    // Registers the calling thread as a waiter. Follow with exactly one of
+    // cancel_wait(), wait() or wait_until().
+    [[nodiscard]] Key prepare_wait() noexcept;
+
+    // The condition turned out true after prepare_wait(); do not sleep.
+    void cancel_wait() noexcept;
+
+    // Sleeps until a notify after prepare_wait() returned key. May also
+    // return spuriously, so callers recheck their condition.
+    void wait(Key key) noexcept;
+
+    // As wait(), giving up at deadline. Returns false on timeout.
+    bool wait_until(Key key, Clock::time_point deadline) noexcept;
+
+    // Wakes one sleeping waiter, if any.
+    void notify_one() noexcept { notify(false); }
+
+    // Wakes every sleeping waiter, if any.
+    void notify_all() noexcept { notify(true); }
+
+private:
+    // state_ packs two counts: registered waiters in the low half, and how
+    // many of them a notify has already signalled in the high half. A
+    // leaving waiter removes itself and consumes one signal, if any.
+    static constexpr unsigned k_signal_shift = 32;
+    static constexpr std::uint64_t k_one_waiter = 1;
+    static constexpr std::uint64_t k_one_signal = std::uint64_t{1} << k_signal_shift;
+
+    [[nodiscard]] static std::uint64_t waiters(std::uint64_t state) noexcept { return state & (k_one_signal - 1); }
+    [[nodiscard]] static std::uint64_t signals(std::uint64_t state) noexcept { return state >> k_signal_shift; }
+
+    void leave() noexcept;
+    void notify(bool all) noexcept;
+
+    // The futex word. Bumped by every notify that signals a waiter.
+    std::atomic<std::uint32_t> epoch_{0};
+    std::atomic<std::uint64_t> state_{0};
+};
+
+} // namespace exemplar
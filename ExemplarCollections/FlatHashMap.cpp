@@ -0,0 +1,6 @@
+#include "FlatHashMap.h"
+
+#include <string>
+
+template class exemplar::FlatHashMap<int, int>;
+template class exemplar::FlatHashMap<std::string, int>;
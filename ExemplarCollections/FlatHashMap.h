@@ -0,0 +1,485 @@
+#pragma once
+
+#include "Transparent.h"
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define EXEMPLAR_FLAT_HASH_MAP_SSE2 1
+#endif
+
+namespace exemplar {
+
+// An open-addressing hash map in the "Swiss table" style.
+// All entries live in one contiguous slot array. A parallel array of
+// one-byte control values records whether each slot is empty, deleted,
+// or full (and for full slots, 7 bits of the hash).
+// Lookups compare 16 control bytes at once (SSE2 when available), so most
+// misses and hits touch a single control group plus one slot.
+template <typename K, typename V, typename Hash = std::hash<K>>
+class FlatHashMap {
+public:
+    FlatHashMap() = default;
+
+    FlatHashMap(const FlatHashMap& other) : hasher_(other.hasher_) {
+        if (other.capacity_ == 0) {
+            return;
+        }
+
+        allocate(other.capacity_);
+        try {
+            for (std::size_t i = 0; i < other.capacity_; ++i) {
+                if (is_full(other.ctrl_[i])) {
+                    const Entry& entry = other.slots_[i];
+                    const std::size_t slot = find_first_non_full(hash_of(entry.key));
+                    std::construct_at(slots_ + slot, entry);
+                    set_ctrl(slot, h2(hash_of(entry.key)));
+                    ++size_;
+                    --growth_left_;
+                }
+            }
+        } catch (...) {
+            destroy_and_deallocate();
+            throw;
+        }
+    }
+
+    FlatHashMap& operator=(const FlatHashMap& other) {
+        if (this == &other) {
+            return *this;
+        }
+
+        FlatHashMap copy(other);
+        swap(copy);
+        return *this;
+    }
+
+    FlatHashMap(FlatHashMap&& other) noexcept { swap(other); }
+
+    FlatHashMap& operator=(FlatHashMap&& other) noexcept {
+        if (this == &other) {
+            return *this;
+        }
+
+        destroy_and_deallocate();
+        swap(other);
+        return *this;
+    }
+
+    ~FlatHashMap() { destroy_and_deallocate(); }
+
+    [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+    [[nodiscard]] std::size_t capacity() const noexcept { return capacity_; }
+
+    [[nodiscard]] static constexpr std::size_t max_size() noexcept { return max_size_for(max_capacity()); }
+
+    // Insert new key or update existing key.
+    // Returns true if inserted new key, false if updated existing key.
+    bool insert_or_assign(const K& key, const V& value) {
+        const std::size_t hash = hash_of(key);
+        if (Entry* entry = find_entry(key, hash)) {
+            entry->value = value;
+            return false;
+        }
+
+        const std::size_t slot = prepare_insert(hash);
+        std::construct_at(slots_ + slot, Entry{key, value});
+        finish_insert(slot, hash);
+        return true;
+    }
+
+    bool insert_or_assign(K&& key, V&& value) {
+        const std::size_t hash = hash_of(key);
+        if (Entry* entry = find_entry(key, hash)) {
+            entry->value = std::move(value);
+            return false;
+        }
+
+        const std::size_t slot = prepare_insert(hash);
+        std::construct_at(slots_ + slot, Entry{std::move(key), std::move(value)});
+        finish_insert(slot, hash);
+        return true;
+    }
+
+    [[nodiscard]] bool contains(const K& key) const { return find_entry(key, hash_of(key)) != nullptr; }
+
+    std::optional<V> get(const K& key) const {
+        if (const Entry* entry = find_entry(key, hash_of(key))) {
+            return entry->value;
+        }
+        return std::nullopt;
+    }
+
+    V& at(const K& key) {
+        if (Entry* entry = find_entry(key, hash_of(key))) {
+            return entry->value;
+        }
+
+        throw std::out_of_range("FlatHashMap::at key not found");
+    }
+
+    const V& at(const K& key) const {
+        if (const Entry* entry = find_entry(key, hash_of(key))) {
+            return entry->value;
+        }
+
+        throw std::out_of_range("FlatHashMap::at key not found");
+    }
+
+    // operator[] inserts a default value if key is missing.
+    V& operator[](const K& key) {
+        const std::size_t hash = hash_of(key);
+        if (Entry* entry = find_entry(key, hash)) {
+            return entry->value;
+        }
+
+        const std::size_t slot = prepare_insert(hash);
+        std::construct_at(slots_ + slot, Entry{key, V{}});
+        finish_insert(slot, hash);
+        return slots_[slot].value;
+    }
+
+    bool erase(const K& key) { return erase_impl(key); }
+
+    // Heterogeneous lookups, enabled when Hash is transparent
+    // (see Transparent.h).
+    template <typename Q>
+        requires transparent<Hash>
+    [[nodiscard]] bool contains(const Q& key) const {
+        return find_entry(key, hash_of(key)) != nullptr;
+    }
+
+    template <typename Q>
+        requires transparent<Hash>
+    std::optional<V> get(const Q& key) const {
+        if (const Entry* entry = find_entry(key, hash_of(key))) {
+            return entry->value;
+        }
+        return std::nullopt;
+    }
+
+    template <typename Q>
+        requires transparent<Hash>
+    V& at(const Q& key) {
+        if (Entry* entry = find_entry(key, hash_of(key))) {
+            return entry->value;
+        }
+
+        throw std::out_of_range("FlatHashMap::at key not found");
+    }
+
+    template <typename Q>
+        requires transparent<Hash>
+    const V& at(const Q& key) const {
+        if (const Entry* entry = find_entry(key, hash_of(key))) {
+            return entry->value;
+        }
+
+        throw std::out_of_range("FlatHashMap::at key not found");
+    }
+
+    template <typename Q>
+        requires transparent<Hash>
+    bool erase(const Q& key) {
+        return erase_impl(key);
+    }
+
+    void clear() noexcept {
+        destroy_entries();
+        if (capacity_ != 0) {
+            std::memset(ctrl_.get(), static_cast<unsigned char>(k_empty), capacity_);
+        }
+        size_ = 0;
+        growth_left_ = max_size_for(capacity_);
+    }
+
+    [[nodiscard]] double load_factor() const noexcept {
+        if (capacity_ == 0) {
+            return 0.0;
+        }
+        return static_cast<double>(size_) / static_cast<double>(capacity_);
+    }
+
+    void swap(FlatHashMap& other) noexcept {
+        std::swap(ctrl_, other.ctrl_);
+        std::swap(slots_, other.slots_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(size_, other.size_);
+        std::swap(growth_left_, other.growth_left_);
+        std::swap(hasher_, other.hasher_);
+    }
+
+private:
+    struct Entry {
+        K key;
+        V value;
+    };
+
+    using ctrl_t = std::int8_t;
+
+    // Control byte encoding:
+    // - empty and deleted have the sign bit set
+    // - full slots store the low 7 bits of the hash (0..127)
+    static constexpr ctrl_t k_empty = -128;
+    static constexpr ctrl_t k_deleted = -2;
+
+    static constexpr std::size_t k_group_width = 16;
+    static constexpr std::size_t k_min_capacity = k_group_width;
+
+    // A 16-slot window of control bytes with bitmask queries.
+    // Bit i of each result mask corresponds to slot i of the group.
+    class Group {
+    public:
+        explicit Group(const ctrl_t* ctrl) noexcept : ctrl_(ctrl) {}
+
+        [[nodiscard]] std::uint32_t match(ctrl_t h2) const noexcept {
+#ifdef EXEMPLAR_FLAT_HASH_MAP_SSE2
+            const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl_));
+            return static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(h2))));
+#else
+            std::uint32_t mask = 0;
+            for (std::size_t i = 0; i < k_group_width; ++i) {
+                mask |= static_cast<std::uint32_t>(ctrl_[i] == h2) << i;
+            }
+            return mask;
+#endif
+        }
+
+        [[nodiscard]] std::uint32_t match_empty() const noexcept { return match(k_empty); }
+
+        // Empty and deleted are the only values with the sign bit set.
+        [[nodiscard]] std::uint32_t match_empty_or_deleted() const noexcept {
+#ifdef EXEMPLAR_FLAT_HASH_MAP_SSE2
+            const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl_));
+            return static_cast<std::uint32_t>(_mm_movemask_epi8(bytes));
+#else
+            std::uint32_t mask = 0;
+            for (std::size_t i = 0; i < k_group_width; ++i) {
+                mask |= static_cast<std::uint32_t>(ctrl_[i] < 0) << i;
+            }
+            return mask;
+#endif
+        }
+
+    private:
+        const ctrl_t* ctrl_;
+    };
+
+    // Visits groups with triangular steps (+1, +2, +3, ...). With a power-of-two
+    // group count this touches every group exactly once.
+    class ProbeSequence {
+    public:
+        ProbeSequence(std::size_t h1, std::size_t group_mask) noexcept : group_(h1 & group_mask), mask_(group_mask) {}
+
+        [[nodiscard]] std::size_t offset() const noexcept { return group_ * k_group_width; }
+
+        void next() noexcept {
+            ++stride_;
+            group_ = (group_ + stride_) & mask_;
+        }
+
+    private:
+        std::size_t group_;
+        std::size_t mask_;
+        std::size_t stride_{0};
+    };
+
+    [[nodiscard]] static bool is_full(ctrl_t ctrl) noexcept { return ctrl >= 0; }
+
+    [[nodiscard]] static std::size_t h1(std::size_t hash) noexcept { return hash >> 7; }
+    [[nodiscard]] static ctrl_t h2(std::size_t hash) noexcept { return static_cast<ctrl_t>(hash & 0x7F); }
+
+    [[nodiscard]] static std::size_t group_start(std::size_t slot) noexcept { return slot & ~(k_group_width - 1); }
+
+    // Keep the table at most 7/8 full.
+    [[nodiscard]] static constexpr std::size_t max_size_for(std::size_t capacity) noexcept {
+        return capacity - capacity / 8;
+    }
+
+    // The largest power of two whose slot array still fits in PTRDIFF_MAX bytes.
+    [[nodiscard]] static constexpr std::size_t max_capacity() noexcept {
+        return std::bit_floor(static_cast<std::size_t>(PTRDIFF_MAX) / sizeof(Entry));
+    }
+
+    // std::hash<int> is the identity on common standard libraries, which would
+    // leave h2 and h1 correlated with the key's low bits. A multiplicative mix
+    // spreads every input bit across the whole word.
+    template <typename Q>
+    [[nodiscard]] std::size_t hash_of(const Q& key) const {
+        std::uint64_t hash = static_cast<std::uint64_t>(hasher_(key)) * 0x9E3779B97F4A7C15ULL;
+        hash ^= hash >> 32;
+        return static_cast<std::size_t>(hash);
+    }
+
+    [[nodiscard]] std::size_t group_mask() const noexcept { return capacity_ / k_group_width - 1; }
+
+    template <typename Q>
+    [[nodiscard]] Entry* find_entry(const Q& key, std::size_t hash) const {
+        if (capacity_ == 0) {
+            return nullptr;
+        }
+
+        ProbeSequence seq(h1(hash), group_mask());
+        while (true) {
+            const Group group(ctrl_.get() + seq.offset());
+            for (std::uint32_t mask = group.match(h2(hash)); mask != 0; mask &= mask - 1) {
+                Entry* entry = slots_ + seq.offset() + static_cast<std::size_t>(std::countr_zero(mask));
+                if (entry->key == key) {
+                    return entry;
+                }
+            }
+
+            if (group.match_empty() != 0) {
+                return nullptr;
+            }
+            seq.next();
+        }
+    }
+
+    template <typename Q>
+    bool erase_impl(const Q& key) {
+        Entry* entry = find_entry(key, hash_of(key));
+        if (entry == nullptr) {
+            return false;
+        }
+
+        const std::size_t slot = static_cast<std::size_t>(entry - slots_);
+        std::destroy_at(entry);
+        --size_;
+
+        // If this slot's group still has an empty byte, no probe sequence ever
+        // continued past it, so the slot can become empty again instead of a
+        // tombstone.
+        if (Group(ctrl_.get() + group_start(slot)).match_empty() != 0) {
+            set_ctrl(slot, k_empty);
+            ++growth_left_;
+        } else {
+            set_ctrl(slot, k_deleted);
+        }
+        return true;
+    }
+
+    [[nodiscard]] std::size_t find_first_non_full(std::size_t hash) const noexcept {
+        ProbeSequence seq(h1(hash), group_mask());
+        while (true) {
+            const std::uint32_t mask = Group(ctrl_.get() + seq.offset()).match_empty_or_deleted();
+            if (mask != 0) {
+                return seq.offset() + static_cast<std::size_t>(std::countr_zero(mask));
+            }
+            seq.next();
+        }
+    }
+
+    // Claims a slot for a key known to be absent and marks it full.
+    // The caller constructs the entry in the returned slot.
+    // Returns the slot a new key with this hash goes to, growing first if
+    // needed. The slot is not claimed until finish_insert(), so a throwing
+    // Entry constructor leaves the table unchanged.
+    std::size_t prepare_insert(std::size_t hash) {
+        if (growth_left_ == 0) {
+            rehash_for_growth();
+        }
+
+        return find_first_non_full(hash);
+    }
+
+    // Marks slot full once its entry has been constructed.
+    void finish_insert(std::size_t slot, std::size_t hash) noexcept {
+        if (ctrl_[slot] == k_empty) {
+            --growth_left_;
+        }
+        set_ctrl(slot, h2(hash));
+        ++size_;
+    }
+
+    void rehash_for_growth() {
+        // Mostly tombstones: rebuild at the same size to reclaim them.
+        // Otherwise double.
+        if (capacity_ != 0 && size_ <= max_size_for(capacity_) / 2) {
+            rehash(capacity_);
+        } else {
+            rehash(capacity_ == 0 ? k_min_capacity : capacity_ * 2);
+        }
+    }
+
+    void rehash(std::size_t new_capacity) {
+        FlatHashMap fresh;
+        fresh.hasher_ = hasher_;
+        fresh.allocate(new_capacity);
+
+        for (std::size_t i = 0; i < capacity_; ++i) {
+            if (is_full(ctrl_[i])) {
+                const std::size_t hash = hash_of(slots_[i].key);
+                const std::size_t slot = fresh.find_first_non_full(hash);
+                std::construct_at(fresh.slots_ + slot, std::move(slots_[i]));
+                fresh.set_ctrl(slot, h2(hash));
+                ++fresh.size_;
+                --fresh.growth_left_;
+            }
+        }
+
+        // The old entries are moved-from; fresh's destructor releases them.
+        swap(fresh);
+    }
+
+    // Installs fresh storage with every control byte empty. Does not touch size_.
+    void allocate(std::size_t capacity) {
+        if (capacity > max_capacity()) {
+            throw std::length_error("FlatHashMap capacity exceeds max_size");
+        }
+
+        ctrl_ = std::make_unique<ctrl_t[]>(capacity);
+        std::memset(ctrl_.get(), static_cast<unsigned char>(k_empty), capacity);
+        slots_ = std::allocator<Entry>{}.allocate(capacity);
+        capacity_ = capacity;
+        growth_left_ = max_size_for(capacity);
+    }
+
+    void set_ctrl(std::size_t slot, ctrl_t value) noexcept { ctrl_[slot] = value; }
+
+    void destroy_entries() noexcept {
+        for (std::size_t i = 0; i < capacity_; ++i) {
+            if (is_full(ctrl_[i])) {
+                std::destroy_at(slots_ + i);
+            }
+        }
+    }
+
+    void destroy_and_deallocate() noexcept {
+        if (capacity_ == 0) {
+            return;
+        }
+
+        destroy_entries();
+        std::allocator<Entry>{}.deallocate(slots_, capacity_);
+        ctrl_.reset();
+        slots_ = nullptr;
+        capacity_ = 0;
+        size_ = 0;
+        growth_left_ = 0;
+    }
+
+    std::unique_ptr<ctrl_t[]> ctrl_{};
+    Entry* slots_{nullptr};
+    std::size_t capacity_{0};
+    std::size_t size_{0};
+    std::size_t growth_left_{0};
+    Hash hasher_{};
+};
+
+template <typename K, typename V, typename Hash>
+void swap(FlatHashMap<K, V, Hash>& left, FlatHashMap<K, V, Hash>& right) noexcept {
+    left.swap(right);
+}
+
+} // namespace exemplar
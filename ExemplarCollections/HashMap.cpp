@@ -1,6 +1,9 @@
 #include "HashMap.h"
 
+#include <memory_resource>
 #include <string>
 
 template class exemplar::HashMap<int, int>;
 template class exemplar::HashMap<std::string, int>;
+template class exemplar::HashMap<int, int, std::hash<int>, std::pmr::polymorphic_allocator<std::pair<const int, int>>>;
+template class exemplar::HashMap<int, int, std::hash<int>, std::allocator<std::pair<const int, int>>, exemplar::CountingStats>;
@@ -1,30 +1,182 @@
 #pragma once
 
+#include "AllocatorSupport.h"
+#include "ContainerStats.h"
+#include "Transparent.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
 #include <optional>
+#include <span>
 #include <stdexcept>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
 namespace exemplar {
 
+// How HashMap moves entries when it grows.
+enum class RehashPolicy {
+    // The insert that crosses the load-factor limit moves every entry.
+    all_at_once,
+    // The old bucket array is kept next to the new one and a few buckets are
+    // moved on each mutating operation (Redis dict style), so no single insert
+    // pays for the whole table.
+    incremental,
+};
+
 // A pedagogical hash map using separate chaining.
 // Buckets are vectors of key-value entries.
 // Rehashing keeps average operations close to O(1).
-template <typename K, typename V, typename Hash = std::hash<K>>
+//
+// The bucket arrays and every bucket's entry storage come from Allocator
+// (rebound as needed). Keys and values themselves are not given the
+// allocator.
+//
+// Stats is a policy from ContainerStats.h. It sees every bucket chain a
+// lookup or insert searches, every rehash and every bucket array
+// allocation (not the per-bucket entry storage); the default NoStats
+// compiles away.
+template <typename K, typename V, typename Hash = std::hash<K>,
+          typename Allocator = std::allocator<std::pair<const K, V>>, typename Stats = NoStats>
 class HashMap {
 public:
-    HashMap() : buckets_(k_default_bucket_count) {}
+    using allocator_type = Allocator;
+
+    HashMap() : HashMap(RehashPolicy::all_at_once) {}
+
+    explicit HashMap(const Allocator& alloc) : HashMap(RehashPolicy::all_at_once, alloc) {}
+
+    explicit HashMap(RehashPolicy policy, const Allocator& alloc = Allocator())
+        : buckets_(make_buckets(k_default_bucket_count, alloc)),
+          policy_(policy),
+          draining_(BucketAllocator(alloc)),
+          retired_(BucketAllocator(alloc)),
+          spare_(BucketAllocator(alloc)) {}
+
+    // Builds from a range of (key, value) pairs, sizing the table once up
+    // front when the range length is known.
+    template <std::input_iterator InputIt>
+    HashMap(InputIt first, InputIt last) : HashMap() {
+        insert_bulk(first, last);
+    }
+
+    // As the implicit members would, except that stats_ is left out: a new
+    // map's counters start at zero, and an assigned-to map keeps its own.
+    //
+    // A moved-from map is empty and has no bucket array; lookups find
+    // nothing, and the next insert allocates the default one.
+    HashMap(const HashMap& other)
+        : HashMap(other,
+                  std::allocator_traits<Allocator>::select_on_container_copy_construction(other.get_allocator())) {}
+
+    HashMap(HashMap&& other) noexcept(std::is_nothrow_move_constructible_v<Hash>)
+        : buckets_(std::move(other.buckets_)),
+          size_(std::exchange(other.size_, 0)),
+          policy_(other.policy_),
+          draining_(std::move(other.draining_)),
+          drain_index_(std::exchange(other.drain_index_, 0)),
+          retired_(std::move(other.retired_)),
+          spare_(std::move(other.spare_)),
+          hasher_(std::move(other.hasher_)) {}
+
+    // Strong guarantee: the copy is built first, with the allocator this
+    // map ends up with, then swapped in.
+    HashMap& operator=(const HashMap& other) {
+        if (this == &other) {
+            return *this;
+        }
+
+        HashMap copy(other,
+                     detail::propagate_on_copy_assignment_v<Allocator> ? other.get_allocator() : get_allocator());
+        swap_contents(copy);
+        return *this;
+    }
+
+    HashMap& operator=(HashMap&& other) noexcept(std::is_nothrow_move_assignable_v<BucketArray> &&
+                                                 std::is_nothrow_move_assignable_v<Hash>) {
+        if (this == &other) {
+            return *this;
+        }
+
+        buckets_ = std::move(other.buckets_);
+        size_ = std::exchange(other.size_, 0);
+        policy_ = other.policy_;
+        draining_ = std::move(other.draining_);
+        drain_index_ = std::exchange(other.drain_index_, 0);
+        retired_ = std::move(other.retired_);
+        spare_ = std::move(other.spare_);
+        hasher_ = std::move(other.hasher_);
+
+        // With unequal, non-propagating allocators the vectors were moved
+        // element by element and other still holds moved-from buckets.
+        release(other.buckets_);
+        release(other.draining_);
+        release(other.retired_);
+        release(other.spare_);
+        return *this;
+    }
 
     [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
     [[nodiscard]] std::size_t size() const noexcept { return size_; }
 
+    [[nodiscard]] RehashPolicy rehash_policy() const noexcept { return policy_; }
+
+    [[nodiscard]] allocator_type get_allocator() const noexcept { return allocator_type(buckets_.get_allocator()); }
+
+    [[nodiscard]] std::size_t bucket_count() const noexcept { return buckets_.size(); }
+
+    [[nodiscard]] const Stats& stats() const noexcept { return stats_; }
+    void reset_stats() noexcept { stats_ = Stats(); }
+
+    // Grows the table so that expected_size entries fit without another
+    // rehash. Never shrinks.
+    void reserve(std::size_t expected_size) {
+        const auto needed = static_cast<std::size_t>(std::ceil(static_cast<double>(expected_size) / k_max_load_factor));
+        const std::size_t new_bucket_count = std::bit_ceil(needed);
+        if (new_bucket_count <= buckets_.size()) {
+            return;
+        }
+
+        if (rehashing()) {
+            finish_rehash();
+        }
+        rehash(new_bucket_count);
+
+        // Any spare array was sized for the old table.
+        release(spare_);
+    }
+
+    // Inserts or assigns every (key, value) pair in [first, last).
+    // Forward ranges reserve room for all of them first, so loading a table
+    // of known size costs one rehash instead of one per doubling.
+    template <std::input_iterator InputIt>
+    void insert_bulk(InputIt first, InputIt last) {
+        if constexpr (std::forward_iterator<InputIt>) {
+            reserve(size_ + static_cast<std::size_t>(std::distance(first, last)));
+        }
+
+        for (; first != last; ++first) {
+            const auto& [key, value] = *first;
+            insert_or_assign(key, value);
+        }
+    }
+
+    // True while an incremental rehash still has old buckets to move.
+    [[nodiscard]] bool rehashing() const noexcept { return !draining_.empty(); }
+
     // Insert new key or update existing key.
     // Returns true if inserted new key, false if updated existing key.
     bool insert_or_assign(const K& key, const V& value) {
         maybe_rehash_for_insert();
-        auto& bucket = buckets_[bucket_index(key)];
+        auto& bucket = bucket_for_write(key);
 
         for (auto& entry : bucket) {
             if (entry.key == key) {
@@ -40,7 +192,7 @@ public:
 
     bool insert_or_assign(K&& key, V&& value) {
         maybe_rehash_for_insert();
-        auto& bucket = buckets_[bucket_index(key)];
+        auto& bucket = bucket_for_write(key);
 
         for (auto& entry : bucket) {
             if (entry.key == key) {
@@ -54,43 +206,64 @@ public:
         return true;
     }
 
-    [[nodiscard]] bool contains(const K& key) const {
-        const auto& bucket = buckets_[bucket_index(key)];
-        for (const auto& entry : bucket) {
-            if (entry.key == key) {
-                return true;
-            }
-        }
-        return false;
-    }
+    [[nodiscard]] bool contains(const K& key) const { return find_entry(key) != nullptr; }
 
     std::optional<V> get(const K& key) const {
-        const auto& bucket = buckets_[bucket_index(key)];
-        for (const auto& entry : bucket) {
-            if (entry.key == key) {
-                return entry.value;
-            }
+        if (const Entry* entry = find_entry(key)) {
+            return entry->value;
         }
         return std::nullopt;
     }
 
     V& at(const K& key) {
-        auto& bucket = buckets_[bucket_index(key)];
-        for (auto& entry : bucket) {
-            if (entry.key == key) {
-                return entry.value;
-            }
+        if (Entry* entry = find_entry(key)) {
+            return entry->value;
         }
 
         throw std::out_of_range("HashMap::at key not found");
     }
 
     const V& at(const K& key) const {
-        const auto& bucket = buckets_[bucket_index(key)];
-        for (const auto& entry : bucket) {
-            if (entry.key == key) {
-                return entry.value;
-            }
+        if (const Entry* entry = find_entry(key)) {
+            return entry->value;
+        }
+
+        throw std::out_of_range("HashMap::at key not found");
+    }
+
+    // Heterogeneous lookups, enabled when Hash is transparent
+    // (see Transparent.h). A HashMap<std::string, V, StringHash> can then be
+    // queried with std::string_view or const char* without allocating.
+    template <typename Q>
+        requires transparent<Hash>
+    [[nodiscard]] bool contains(const Q& key) const {
+        return find_entry(key) != nullptr;
+    }
+
+    template <typename Q>
+        requires transparent<Hash>
+    std::optional<V> get(const Q& key) const {
+        if (const Entry* entry = find_entry(key)) {
+            return entry->value;
+        }
+        return std::nullopt;
+    }
+
+    template <typename Q>
+        requires transparent<Hash>
+    V& at(const Q& key) {
+        if (Entry* entry = find_entry(key)) {
+            return entry->value;
+        }
+
+        throw std::out_of_range("HashMap::at key not found");
+    }
+
+    template <typename Q>
+        requires transparent<Hash>
+    const V& at(const Q& key) const {
+        if (const Entry* entry = find_entry(key)) {
+            return entry->value;
         }
 
         throw std::out_of_range("HashMap::at key not found");
@@ -99,7 +272,7 @@ public:
     // operator[] inserts a default value if key is missing.
     V& operator[](const K& key) {
         maybe_rehash_for_insert();
-        auto& bucket = buckets_[bucket_index(key)];
+        auto& bucket = bucket_for_write(key);
 
         for (auto& entry : bucket) {
             if (entry.key == key) {
@@ -112,21 +285,20 @@ public:
         return bucket.back().value;
     }
 
-    bool erase(const K& key) {
-        auto& bucket = buckets_[bucket_index(key)];
-        for (std::size_t i = 0; i < bucket.size(); ++i) {
-            if (bucket[i].key == key) {
-                bucket[i] = std::move(bucket.back());
-                bucket.pop_back();
-                --size_;
-                return true;
-            }
-        }
-        return false;
+    bool erase(const K& key) { return erase_impl(key); }
+
+    template <typename Q>
+        requires transparent<Hash>
+    bool erase(const Q& key) {
+        return erase_impl(key);
     }
 
     void clear() {
-        buckets_.assign(k_default_bucket_count, {});
+        buckets_.assign(k_default_bucket_count, Bucket(EntryAllocator(get_allocator())));
+        release(draining_);
+        drain_index_ = 0;
+        release(retired_);
+        release(spare_);
         size_ = 0;
     }
 
@@ -137,6 +309,49 @@ public:
         return static_cast<double>(size_) / static_cast<double>(buckets_.size());
     }
 
+    // Batched lookup: out[i] = get(keys[i]).
+    // Keys go through a three-stage pipeline: prefetch the key's bucket,
+    // some keys later prefetch the bucket's entry storage, and some keys
+    // after that compare. On tables much larger than the last-level cache
+    // this keeps a steady number of misses in flight instead of paying them
+    // one after another. Batches under 16 keys are looked up one by one.
+    void get_many(std::span<const K> keys, std::span<std::optional<V>> out) const {
+        if (out.size() != keys.size()) {
+            throw std::invalid_argument("HashMap::get_many output size does not match key count");
+        }
+
+        resolve_batch(keys, [&](std::size_t i, const Entry* entry) {
+            out[i] = entry != nullptr ? std::optional<V>(entry->value) : std::nullopt;
+        });
+    }
+
+    // Batched contains: out[i] = contains(keys[i]). See get_many.
+    void contains_many(std::span<const K> keys, std::span<bool> out) const {
+        if (out.size() != keys.size()) {
+            throw std::invalid_argument("HashMap::contains_many output size does not match key count");
+        }
+
+        resolve_batch(keys, [&](std::size_t i, const Entry* entry) { out[i] = entry != nullptr; });
+    }
+
+    // Calls fn(key, value) for every entry, in unspecified order.
+    // fn must not insert into or erase from this map.
+    template <typename Fn>
+    void for_each(Fn&& fn) const {
+        for (const auto& bucket : buckets_) {
+            for (const auto& entry : bucket) {
+                fn(entry.key, entry.value);
+            }
+        }
+
+        // Old buckets below drain_index_ are already empty.
+        for (std::size_t i = drain_index_; i < draining_.size(); ++i) {
+            for (const auto& entry : draining_[i]) {
+                fn(entry.key, entry.value);
+            }
+        }
+    }
+
 private:
     struct Entry {
         K key;
@@ -146,24 +361,225 @@ private:
     static constexpr std::size_t k_default_bucket_count = 8;
     static constexpr double k_max_load_factor = 0.75;
 
-    [[nodiscard]] std::size_t bucket_index(const K& key) const {
-        return hasher_(key) % buckets_.size();
+    // Old buckets moved per mutating operation during an incremental rehash.
+    // A table of B buckets grows again after 0.75 * B more inserts, and at this
+    // rate the previous migration finishes after B / 4 of them.
+    static constexpr std::size_t k_rehash_buckets_per_operation = 4;
+
+    // Empty buckets built or destroyed per mutating operation outside a
+    // migration. Building the 2N-bucket spare and destroying the N/2 old
+    // buckets then fits comfortably in the 0.375 * N inserts before the
+    // next growth.
+    static constexpr std::size_t k_bucket_setup_per_operation = 16;
+
+    using EntryAllocator = detail::rebind_alloc_t<Allocator, Entry>;
+    using Bucket = std::vector<Entry, EntryAllocator>;
+    using BucketAllocator = detail::rebind_alloc_t<Allocator, Bucket>;
+    using BucketArray = std::vector<Bucket, BucketAllocator>;
+
+    HashMap(const HashMap& other, const Allocator& alloc)
+        : buckets_(other.buckets_, BucketAllocator(alloc)),
+          size_(other.size_),
+          policy_(other.policy_),
+          draining_(other.draining_, BucketAllocator(alloc)),
+          drain_index_(other.drain_index_),
+          retired_(other.retired_, BucketAllocator(alloc)),
+          spare_(other.spare_, BucketAllocator(alloc)),
+          hasher_(other.hasher_) {}
+
+    // Swaps everything but stats_. Both maps must use equal allocators.
+    void swap_contents(HashMap& other) noexcept(std::is_nothrow_swappable_v<Hash>) {
+        using std::swap;
+        buckets_.swap(other.buckets_);
+        swap(size_, other.size_);
+        swap(policy_, other.policy_);
+        draining_.swap(other.draining_);
+        swap(drain_index_, other.drain_index_);
+        retired_.swap(other.retired_);
+        spare_.swap(other.spare_);
+        swap(hasher_, other.hasher_);
+    }
+
+    [[nodiscard]] static BucketArray make_buckets(std::size_t count, const Allocator& alloc) {
+        return BucketArray(count, Bucket(EntryAllocator(alloc)), BucketAllocator(alloc));
+    }
+
+    // Frees a vector's storage. Assigning {} would not: the empty temporary
+    // has a default-constructed allocator, and a pmr vector that does not
+    // take it keeps its old block.
+    template <typename Vector>
+    static void release(Vector& vector) noexcept {
+        Vector(vector.get_allocator()).swap(vector);
+    }
+
+    // Bucket counts are always powers of two, so the index is a mask rather
+    // than an integer division. Masking keeps only the low bits, and
+    // std::hash<int> is the identity, so the hash is mixed first: the
+    // multiply spreads each input bit upwards and the shift folds the well
+    // mixed high half back into the low bits.
+    [[nodiscard]] static std::size_t bucket_index(std::size_t hash, std::size_t bucket_count) noexcept {
+        std::uint64_t mixed = static_cast<std::uint64_t>(hash) * 0x9E3779B97F4A7C15ULL;
+        mixed ^= mixed >> 32;
+        return static_cast<std::size_t>(mixed) & (bucket_count - 1);
+    }
+
+    template <typename Q>
+    [[nodiscard]] static const Entry* find_in_bucket(const Bucket& bucket, const Q& key) {
+        for (const auto& entry : bucket) {
+            if (entry.key == key) {
+                return &entry;
+            }
+        }
+        return nullptr;
+    }
+
+    // During an incremental rehash a key lives in exactly one of the two
+    // arrays: the new one, or an old bucket that has not been moved yet.
+    template <typename Q>
+    [[nodiscard]] const Entry* find_entry(const Q& key) const {
+        if (buckets_.empty()) {
+            return nullptr;
+        }
+
+        const std::size_t hash = hasher_(key);
+        const Bucket& bucket = buckets_[bucket_index(hash, buckets_.size())];
+        stats_.on_probe(bucket.size());
+        if (const Entry* entry = find_in_bucket(bucket, key)) {
+            return entry;
+        }
+
+        if (rehashing()) {
+            const std::size_t old_index = bucket_index(hash, draining_.size());
+            if (old_index >= drain_index_) {
+                stats_.on_probe(draining_[old_index].size());
+                return find_in_bucket(draining_[old_index], key);
+            }
+        }
+        return nullptr;
+    }
+
+    template <typename Q>
+    [[nodiscard]] Entry* find_entry(const Q& key) {
+        return const_cast<Entry*>(std::as_const(*this).find_entry(key));
+    }
+
+    // Lookups in flight in resolve_batch: a key's bucket is prefetched
+    // this many keys before its entry storage, and that this many keys
+    // before its comparison. Enough to cover a miss to memory, few enough
+    // that the prefetches fit in the core's outstanding-miss buffers.
+    static constexpr std::size_t k_prefetch_distance = 16;
+
+    // Below this many keys the pipeline cannot fill; the plain loop, whose
+    // independent lookups the CPU already overlaps, is as fast.
+    static constexpr std::size_t k_min_batch = 16;
+
+    static void prefetch(const void* address) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(address);
+#else
+        (void)address;
+#endif
+    }
+
+    template <typename Emit>
+    void resolve_batch(std::span<const K> keys, Emit&& emit) const {
+        // Keys may sit in either array mid-migration; take the plain path
+        // then, for batches too small to pipeline, and without buckets.
+        if (rehashing() || keys.size() < k_min_batch || buckets_.empty()) {
+            for (std::size_t i = 0; i < keys.size(); ++i) {
+                emit(i, find_entry(keys[i]));
+            }
+            return;
+        }
+
+        // Three stages, k_prefetch_distance keys apart: key i + 2d has its
+        // bucket prefetched, key i + d reads its (by then cached) bucket
+        // and prefetches the entry storage, and key i is compared.
+        constexpr std::size_t d = k_prefetch_distance;
+        constexpr std::size_t ring_size = std::bit_ceil(2 * d + 1);
+        const Bucket* in_flight[ring_size];
+        const std::size_t count = keys.size();
+        for (std::size_t i = 0; i < count + 2 * d; ++i) {
+            if (i < count) {
+                in_flight[i % ring_size] = &buckets_[bucket_index(hasher_(keys[i]), buckets_.size())];
+                prefetch(in_flight[i % ring_size]);
+            }
+            if (i >= d && i - d < count) {
+                const Bucket* bucket = in_flight[(i - d) % ring_size];
+                if (!bucket->empty()) {
+                    prefetch(bucket->data());
+                }
+            }
+            if (i >= 2 * d) {
+                const std::size_t j = i - 2 * d;
+                const Bucket* bucket = in_flight[j % ring_size];
+                stats_.on_probe(bucket->size());
+                emit(j, find_in_bucket(*bucket, keys[j]));
+            }
+        }
+    }
+
+    // Returns key's bucket in the new array. If a rehash is in flight, the
+    // key's old bucket is moved first so the caller only has to search one
+    // bucket.
+    template <typename Q>
+    Bucket& bucket_for_write(const Q& key) {
+        const std::size_t hash = hasher_(key);
+        if (rehashing()) {
+            migrate_bucket(bucket_index(hash, draining_.size()));
+        }
+
+        Bucket& bucket = buckets_[bucket_index(hash, buckets_.size())];
+        stats_.on_probe(bucket.size());
+        return bucket;
+    }
+
+    template <typename Q>
+    bool erase_impl(const Q& key) {
+        if (buckets_.empty()) {
+            return false;
+        }
+
+        advance_rehash();
+        auto& bucket = bucket_for_write(key);
+        for (std::size_t i = 0; i < bucket.size(); ++i) {
+            if (bucket[i].key == key) {
+                bucket[i] = std::move(bucket.back());
+                bucket.pop_back();
+                --size_;
+                return true;
+            }
+        }
+        return false;
     }
 
     void maybe_rehash_for_insert() {
+        if (buckets_.empty()) {
+            rehash(k_default_bucket_count);
+            return;
+        }
+
+        advance_rehash();
+
         const std::size_t next_size = size_ + 1;
         const double next_load = static_cast<double>(next_size) / static_cast<double>(buckets_.size());
         if (next_load > k_max_load_factor) {
-            rehash(buckets_.size() * 2);
+            if (policy_ == RehashPolicy::incremental) {
+                begin_incremental_rehash(buckets_.size() * 2);
+            } else {
+                rehash(buckets_.size() * 2);
+            }
         }
     }
 
     void rehash(std::size_t new_bucket_count) {
-        std::vector<std::vector<Entry>> new_buckets(new_bucket_count);
+        BucketArray new_buckets = make_buckets(new_bucket_count, get_allocator());
+        stats_.on_allocation(new_bucket_count * sizeof(Bucket));
+        stats_.on_rehash(buckets_.size(), new_bucket_count);
 
         for (auto& bucket : buckets_) {
             for (auto& entry : bucket) {
-                const std::size_t index = hasher_(entry.key) % new_bucket_count;
+                const std::size_t index = bucket_index(hasher_(entry.key), new_bucket_count);
                 new_buckets[index].push_back(std::move(entry));
             }
         }
@@ -171,9 +587,120 @@ private:
         buckets_ = std::move(new_buckets);
     }
 
-    std::vector<std::vector<Entry>> buckets_;
+    // Swaps in the pre-built spare array; entries move later in
+    // advance_rehash().
+    void begin_incremental_rehash(std::size_t new_bucket_count) {
+        if (rehashing()) {
+            finish_rehash();
+        }
+
+        // Normally a no-op: advance_rehash() has already built every bucket.
+        reserve_spare(new_bucket_count);
+        spare_.resize(new_bucket_count);
+        stats_.on_rehash(buckets_.size(), new_bucket_count);
+
+        draining_ = std::move(buckets_);
+        buckets_ = std::move(spare_);
+        release(spare_);
+        drain_index_ = 0;
+    }
+
+    // One bounded slice of incremental-rehash work per mutating operation:
+    // 1) move a few old buckets into the new array,
+    // 2) then destroy the emptied old array a few buckets at a time,
+    // 3) then pre-build the next, twice-as-large array a few buckets at a time.
+    // Steps 2 and 3 keep the page faults of zero-filling a multi-GB bucket
+    // array, and the loop that destroys one, out of any single operation.
+    void advance_rehash() {
+        if (policy_ != RehashPolicy::incremental) {
+            return;
+        }
+
+        if (rehashing()) {
+            for (std::size_t step = 0; step < k_rehash_buckets_per_operation && drain_index_ < draining_.size(); ++step) {
+                migrate_bucket(drain_index_++);
+            }
+
+            if (drain_index_ == draining_.size()) {
+                retired_ = std::move(draining_);
+                release(draining_);
+                drain_index_ = 0;
+            }
+            return;
+        }
+
+        if (!retired_.empty()) {
+            for (std::size_t step = 0; step < k_bucket_setup_per_operation && !retired_.empty(); ++step) {
+                retired_.pop_back();
+            }
+
+            if (retired_.empty()) {
+                release(retired_);
+            }
+            return;
+        }
+
+        // reserve() maps the memory without touching it; the pages are
+        // faulted in gradually by emplace_back().
+        const std::size_t next_bucket_count = buckets_.size() * 2;
+        reserve_spare(next_bucket_count);
+        for (std::size_t step = 0; step < k_bucket_setup_per_operation && spare_.size() < next_bucket_count; ++step) {
+            spare_.emplace_back();
+        }
+    }
+
+    void reserve_spare(std::size_t bucket_count) {
+        if (spare_.capacity() < bucket_count) {
+            spare_.reserve(bucket_count);
+            stats_.on_allocation(bucket_count * sizeof(Bucket));
+        }
+    }
+
+    // Fallback when the table must grow again before the previous migration
+    // finished (e.g. long runs of lookups between inserts cannot help).
+    void finish_rehash() {
+        while (drain_index_ < draining_.size()) {
+            migrate_bucket(drain_index_++);
+        }
+
+        release(draining_);
+        drain_index_ = 0;
+    }
+
+    void migrate_bucket(std::size_t old_index) {
+        Bucket& old_bucket = draining_[old_index];
+        for (auto& entry : old_bucket) {
+            buckets_[bucket_index(hasher_(entry.key), buckets_.size())].push_back(std::move(entry));
+        }
+
+        // Release the old bucket's storage now rather than all at the end.
+        release(old_bucket);
+    }
+
+    BucketArray buckets_;
     std::size_t size_{0};
+    RehashPolicy policy_{RehashPolicy::all_at_once};
+
+    // Old bucket array while an incremental rehash is in flight.
+    // Buckets below drain_index_ have already been moved into buckets_.
+    BucketArray draining_;
+    std::size_t drain_index_{0};
+
+    // Incremental policy only: the fully drained old array awaiting
+    // destruction, and the next bucket array being built ahead of time.
+    BucketArray retired_;
+    BucketArray spare_;
     Hash hasher_{};
+
+    // Updated by const lookups as well, hence mutable.
+    [[no_unique_address]] mutable Stats stats_{};
 };
 
+namespace pmr {
+
+template <typename K, typename V, typename Hash = std::hash<K>>
+using HashMap = exemplar::HashMap<K, V, Hash, std::pmr::polymorphic_allocator<std::pair<const K, V>>>;
+
+} // namespace pmr
+
 } // namespace exemplar
@@ -0,0 +1,245 @@
+#include "HashMapSnapshot.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace exemplar::detail {
+
+bool build_displacements(const std::vector<std::uint64_t>& hashes, std::uint64_t bucket_count,
+                         std::vector<std::uint32_t>& displacements) {
+    const std::uint64_t slot_count = hashes.size();
+    displacements.assign(bucket_count, 0);
+    if (slot_count == 0) {
+        return true;
+    }
+
+    // Counting sort of key indices by bucket.
+    std::vector<std::uint64_t> bucket_start(bucket_count + 1, 0);
+    for (std::uint64_t hash : hashes) {
+        ++bucket_start[hash % bucket_count + 1];
+    }
+    for (std::uint64_t b = 0; b < bucket_count; ++b) {
+        bucket_start[b + 1] += bucket_start[b];
+    }
+
+    std::vector<std::uint64_t> keys_by_bucket(slot_count);
+    std::vector<std::uint64_t> fill = bucket_start;
+    for (std::uint64_t i = 0; i < slot_count; ++i) {
+        keys_by_bucket[fill[hashes[i] % bucket_count]++] = i;
+    }
+
+    // Largest buckets first: they are the hardest to place, so they get the
+    // emptiest table.
+    std::vector<std::uint64_t> order(bucket_count);
+    for (std::uint64_t b = 0; b < bucket_count; ++b) {
+        order[b] = b;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](std::uint64_t left, std::uint64_t right) {
+        return bucket_start[left + 1] - bucket_start[left] > bucket_start[right + 1] - bucket_start[right];
+    });
+
+    constexpr std::uint32_t k_max_displacement = 1u << 24;
+
+    std::vector<bool> taken(slot_count, false);
+    std::vector<std::uint64_t> candidate;
+    std::uint64_t next_free = 0;
+
+    for (std::uint64_t bucket : order) {
+        const std::uint64_t begin = bucket_start[bucket];
+        const std::uint64_t end = bucket_start[bucket + 1];
+        const std::uint64_t bucket_size = end - begin;
+
+        if (bucket_size == 0) {
+            break;
+        }
+
+        // A single key can simply take the next free slot.
+        if (bucket_size == 1) {
+            while (taken[next_free]) {
+                ++next_free;
+            }
+            taken[next_free] = true;
+            displacements[bucket] = k_direct_slot_flag | static_cast<std::uint32_t>(next_free);
+            continue;
+        }
+
+        bool placed = false;
+        for (std::uint32_t displacement = 0; displacement < k_max_displacement && !placed; ++displacement) {
+            candidate.clear();
+            bool fits = true;
+            for (std::uint64_t k = begin; k < end && fits; ++k) {
+                const std::uint64_t slot = snapshot_slot(hashes[keys_by_bucket[k]], displacement, slot_count);
+                fits = !taken[slot] && std::find(candidate.begin(), candidate.end(), slot) == candidate.end();
+                candidate.push_back(slot);
+            }
+
+            if (fits) {
+                for (std::uint64_t slot : candidate) {
+                    taken[slot] = true;
+                }
+                displacements[bucket] = displacement;
+                placed = true;
+            }
+        }
+
+        if (!placed) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+MappedFile::MappedFile(const std::string& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw std::runtime_error("MappedFile could not open " + path);
+    }
+
+    struct stat info {};
+    if (::fstat(fd, &info) != 0) {
+        ::close(fd);
+        throw std::runtime_error("MappedFile could not stat " + path);
+    }
+
+    size_ = static_cast<std::size_t>(info.st_size);
+    if (size_ != 0) {
+        void* mapping = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+        if (mapping == MAP_FAILED) {
+            ::close(fd);
+            throw std::runtime_error("MappedFile could not map " + path);
+        }
+        data_ = static_cast<const std::byte*>(mapping);
+    }
+
+    // The mapping keeps the file contents alive on its own.
+    ::close(fd);
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)) {}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this == &other) {
+        return *this;
+    }
+
+    release();
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+    return *this;
+}
+
+MappedFile::~MappedFile() { release(); }
+
+void MappedFile::release() noexcept {
+    if (data_ != nullptr) {
+        ::munmap(const_cast<std::byte*>(data_), size_);
+    }
+    data_ = nullptr;
+    size_ = 0;
+}
+
+namespace {
+
+// Writes all of [data, data + size) to fd, retrying short writes.
+bool write_all(int fd, const void* data, std::uint64_t size) {
+    const auto* bytes = static_cast<const char*>(data);
+    while (size != 0) {
+        const ::ssize_t written = ::write(fd, bytes, size);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        bytes += written;
+        size -= static_cast<std::uint64_t>(written);
+    }
+    return true;
+}
+
+} // namespace
+
+void write_snapshot_file(const std::string& path, const SnapshotHeader& header, const std::vector<std::uint32_t>& displacements,
+                         const std::vector<std::byte>& records, const std::vector<std::byte>& strings) {
+    // Other processes may have the current file mapped. Rewriting it in
+    // place would let them read a half-written table or fault on the
+    // truncated tail, so the image goes to a temporary file in the same
+    // directory, which then replaces path atomically. Existing mappings
+    // keep the old inode alive; new readers see the new one.
+    std::string temp_path = path + ".tmp.XXXXXX";
+    const int fd = ::mkstemp(temp_path.data());
+    if (fd < 0) {
+        throw std::runtime_error("HashMapSnapshot::write could not create a temporary file next to " + path);
+    }
+
+    const std::uint64_t displacement_bytes = displacements.size() * sizeof(std::uint32_t);
+    const std::vector<char> zeros(header.record_offset - header.displacement_offset - displacement_bytes, 0);
+
+    const bool written = ::fchmod(fd, 0644) == 0 && write_all(fd, &header, sizeof(header)) &&
+                         write_all(fd, displacements.data(), displacement_bytes) &&
+                         write_all(fd, zeros.data(), zeros.size()) && write_all(fd, records.data(), records.size()) &&
+                         write_all(fd, strings.data(), strings.size()) && ::fsync(fd) == 0;
+    const bool closed = ::close(fd) == 0;
+
+    if (!written || !closed || ::rename(temp_path.c_str(), path.c_str()) != 0) {
+        ::unlink(temp_path.c_str());
+        throw std::runtime_error("HashMapSnapshot::write failed writing " + path);
+    }
+}
+
+SnapshotHeader validate_snapshot(const MappedFile& file, std::uint32_t flags, std::uint32_t key_size, std::uint32_t value_size,
+                                 std::uint32_t record_size) {
+    SnapshotHeader header{};
+    if (file.size() < sizeof(header)) {
+        throw std::runtime_error("HashMapSnapshot file too small");
+    }
+    std::memcpy(&header, file.data(), sizeof(header));
+
+    if (std::memcmp(header.magic, k_snapshot_magic, sizeof(header.magic)) != 0) {
+        throw std::runtime_error("HashMapSnapshot bad magic");
+    }
+    if (header.version != k_snapshot_version) {
+        throw std::runtime_error("HashMapSnapshot unsupported version");
+    }
+    if (header.flags != flags || header.key_size != key_size || header.value_size != value_size ||
+        header.record_size != record_size) {
+        throw std::runtime_error("HashMapSnapshot key/value types do not match the file");
+    }
+    if (header.file_size != file.size()) {
+        throw std::runtime_error("HashMapSnapshot file size mismatch");
+    }
+
+    // Every section must lie inside the file, in order. The offsets are
+    // ordered first, so no subtraction below can wrap, and the sizes are
+    // compared by division, so no multiplication can overflow either.
+    const bool offsets_ordered = header.displacement_offset >= sizeof(header) &&
+                                 header.displacement_offset <= header.record_offset &&
+                                 header.record_offset <= header.string_offset && header.string_offset <= header.file_size;
+    const bool sections_fit =
+        offsets_ordered &&
+        header.bucket_count <= (header.record_offset - header.displacement_offset) / sizeof(std::uint32_t) &&
+        header.entry_count <= (header.string_offset - header.record_offset) / record_size;
+    if (!sections_fit || (header.entry_count != 0 && header.bucket_count == 0)) {
+        throw std::runtime_error("HashMapSnapshot corrupt section offsets");
+    }
+
+    return header;
+}
+
+} // namespace exemplar::detail
+
+template class exemplar::HashMapSnapshot<int, int>;
+template class exemplar::HashMapSnapshot<std::string, int>;
+template class exemplar::HashMapSnapshot<std::string, std::string>;
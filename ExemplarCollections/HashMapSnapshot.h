@@ -0,0 +1,359 @@
+#pragma once
+
+#include "HashMap.h"
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace exemplar {
+
+// Snapshot values and keys are either trivially copyable (stored inline as
+// raw bytes) or std::string (stored as a length-prefixed byte string).
+// Keys are hashed by their bytes, so trivially copyable keys must not
+// contain padding or other bits that can differ between equal values.
+template <typename T>
+concept snapshot_value = std::is_trivially_copyable_v<T> || std::same_as<T, std::string>;
+
+template <typename T>
+concept snapshot_key =
+    (std::is_trivially_copyable_v<T> && std::has_unique_object_representations_v<T>) || std::same_as<T, std::string>;
+
+namespace detail {
+
+// On-disk layout (native byte order, so images are not portable between
+// little- and big-endian machines):
+//   SnapshotHeader
+//   std::uint32_t displacements[bucket_count]   perfect hash parameters
+//   Record records[entry_count]                  one slot per entry
+//   string data                                  u32 length + bytes, per string
+struct SnapshotHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t flags;
+    std::uint32_t key_size;
+    std::uint32_t value_size;
+    std::uint32_t record_size;
+    std::uint32_t reserved;
+    std::uint64_t entry_count;
+    std::uint64_t bucket_count;
+    std::uint64_t seed;
+    std::uint64_t displacement_offset;
+    std::uint64_t record_offset;
+    std::uint64_t string_offset;
+    std::uint64_t file_size;
+};
+
+inline constexpr char k_snapshot_magic[8] = {'E', 'X', 'H', 'M', 'S', 'N', 'A', 'P'};
+inline constexpr std::uint32_t k_snapshot_version = 1;
+inline constexpr std::uint32_t k_snapshot_key_is_string = 1u << 0;
+inline constexpr std::uint32_t k_snapshot_value_is_string = 1u << 1;
+
+// A displacement with this bit set names its bucket's only slot directly.
+inline constexpr std::uint32_t k_direct_slot_flag = 0x8000'0000u;
+
+// MurmurHash3's 64-bit finalizer.
+[[nodiscard]] inline std::uint64_t mix64(std::uint64_t x) noexcept {
+    x ^= x >> 33;
+    x *= 0xFF51AFD7ED558CCDULL;
+    x ^= x >> 33;
+    x *= 0xC4CEB9FE1A85EC53ULL;
+    x ^= x >> 33;
+    return x;
+}
+
+// A seeded byte hash with a fixed definition. std::hash may differ between
+// standard libraries and builds, which would make on-disk images unreadable.
+[[nodiscard]] inline std::uint64_t snapshot_hash(const void* data, std::size_t length, std::uint64_t seed) noexcept {
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    std::uint64_t hash = mix64(seed + length * 0x9E3779B97F4A7C15ULL);
+
+    while (length >= 8) {
+        std::uint64_t word;
+        std::memcpy(&word, bytes, 8);
+        hash = mix64(hash ^ word) * 0x9E3779B97F4A7C15ULL;
+        bytes += 8;
+        length -= 8;
+    }
+
+    std::uint64_t tail = 0;
+    std::memcpy(&tail, bytes, length);
+    return mix64(hash ^ tail);
+}
+
+[[nodiscard]] inline std::uint64_t snapshot_slot(std::uint64_t hash, std::uint32_t displacement, std::uint64_t slot_count) noexcept {
+    if ((displacement & k_direct_slot_flag) != 0) {
+        return displacement & ~k_direct_slot_flag;
+    }
+    return mix64(hash ^ (static_cast<std::uint64_t>(displacement) * 0xC2B2AE3D27D4EB4FULL)) % slot_count;
+}
+
+// Builds a minimal perfect hash ("hash, displace and compress" style) over
+// hashes.size() keys: keys are grouped into bucket_count buckets by
+// hash % bucket_count, and each bucket gets a displacement that sends its keys
+// to distinct free slots in [0, hashes.size()). Largest buckets are placed
+// first; single-key buckets take the leftover slots directly.
+// Returns false if two keys cannot be separated (e.g. equal hashes), in which
+// case the caller retries with another seed.
+bool build_displacements(const std::vector<std::uint64_t>& hashes, std::uint64_t bucket_count,
+                         std::vector<std::uint32_t>& displacements);
+
+// A read-only, shared memory mapping of a whole file.
+class MappedFile {
+public:
+    MappedFile() = default;
+    explicit MappedFile(const std::string& path);
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    ~MappedFile();
+
+    [[nodiscard]] const std::byte* data() const noexcept { return data_; }
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+
+private:
+    void release() noexcept;
+
+    const std::byte* data_{nullptr};
+    std::size_t size_{0};
+};
+
+// Writes header + sections to a temporary file next to path, fsyncs it and
+// renames it over path, so processes mapping the old file never see a
+// partial image. Throws std::runtime_error on I/O failure.
+void write_snapshot_file(const std::string& path, const SnapshotHeader& header, const std::vector<std::uint32_t>& displacements,
+                         const std::vector<std::byte>& records, const std::vector<std::byte>& strings);
+
+// Throws std::runtime_error unless file holds a well-formed image with the
+// expected key/value encoding.
+SnapshotHeader validate_snapshot(const MappedFile& file, std::uint32_t flags, std::uint32_t key_size, std::uint32_t value_size,
+                                 std::uint32_t record_size);
+
+} // namespace detail
+
+// An immutable, memory-mapped image of a HashMap.
+//
+// HashMapSnapshot<K, V>::write(map, path) lays the entries out in a file
+// indexed by a minimal perfect hash: every key maps to its own slot, so a
+// lookup is one hash, one displacement read and one record read.
+//
+// A HashMapSnapshot object maps such a file read-only and answers get() and
+// contains() straight from the page cache. Opening costs a few syscalls
+// regardless of entry count, and several processes mapping the same file
+// share one copy of its pages.
+//
+// std::string keys and values are returned as std::string_view into the
+// mapping; they stay valid for the lifetime of the snapshot object.
+template <snapshot_key K, snapshot_value V>
+class HashMapSnapshot {
+public:
+    using key_view_type = std::conditional_t<std::same_as<K, std::string>, std::string_view, const K&>;
+    using value_view_type = std::conditional_t<std::same_as<V, std::string>, std::string_view, V>;
+
+    explicit HashMapSnapshot(const std::string& path)
+        : file_(path), header_(detail::validate_snapshot(file_, k_flags, sizeof(StoredKey), sizeof(StoredValue), sizeof(Record))) {}
+
+    [[nodiscard]] bool empty() const noexcept { return header_.entry_count == 0; }
+    [[nodiscard]] std::size_t size() const noexcept { return static_cast<std::size_t>(header_.entry_count); }
+
+    [[nodiscard]] bool contains(key_view_type key) const { return find_record(key).has_value(); }
+
+    std::optional<value_view_type> get(key_view_type key) const {
+        if (std::optional<Record> record = find_record(key)) {
+            return value_view(record->value);
+        }
+        return std::nullopt;
+    }
+
+    // Writes every entry of map to path, atomically replacing any existing
+    // file; snapshots already open keep reading the old one.
+    template <typename Hash>
+    static void write(const HashMap<K, V, Hash>& map, const std::string& path) {
+        std::vector<const K*> keys;
+        std::vector<const V*> values;
+        keys.reserve(map.size());
+        values.reserve(map.size());
+        map.for_each([&](const K& key, const V& value) {
+            keys.push_back(&key);
+            values.push_back(&value);
+        });
+
+        const std::uint64_t entry_count = keys.size();
+        if (entry_count >= detail::k_direct_slot_flag) {
+            throw std::runtime_error("HashMapSnapshot::write too many entries");
+        }
+
+        // About four keys per bucket keeps displacement searches short.
+        const std::uint64_t bucket_count = entry_count == 0 ? 0 : (entry_count + 3) / 4;
+
+        std::vector<std::uint64_t> hashes(entry_count);
+        std::vector<std::uint32_t> displacements;
+        std::uint64_t seed = 0;
+        for (;; ++seed) {
+            if (seed == k_max_seed_attempts) {
+                throw std::runtime_error("HashMapSnapshot::write could not build a perfect hash");
+            }
+
+            for (std::size_t i = 0; i < keys.size(); ++i) {
+                hashes[i] = hash_key(key_view(*keys[i]), seed);
+            }
+            if (detail::build_displacements(hashes, bucket_count, displacements)) {
+                break;
+            }
+        }
+
+        std::vector<std::byte> records(entry_count * sizeof(Record));
+        std::vector<std::byte> strings;
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            Record record{};
+            record.key = store(*keys[i], strings);
+            record.value = store(*values[i], strings);
+
+            const std::uint64_t slot =
+                detail::snapshot_slot(hashes[i], displacements[hashes[i] % bucket_count], entry_count);
+            std::memcpy(records.data() + slot * sizeof(Record), &record, sizeof(Record));
+        }
+
+        detail::SnapshotHeader header{};
+        std::memcpy(header.magic, detail::k_snapshot_magic, sizeof(header.magic));
+        header.version = detail::k_snapshot_version;
+        header.flags = k_flags;
+        header.key_size = sizeof(StoredKey);
+        header.value_size = sizeof(StoredValue);
+        header.record_size = sizeof(Record);
+        header.entry_count = entry_count;
+        header.bucket_count = bucket_count;
+        header.seed = seed;
+        header.displacement_offset = sizeof(detail::SnapshotHeader);
+        header.record_offset = align_up(header.displacement_offset + bucket_count * sizeof(std::uint32_t), k_section_alignment);
+        header.string_offset = header.record_offset + records.size();
+        header.file_size = header.string_offset + strings.size();
+
+        detail::write_snapshot_file(path, header, displacements, records, strings);
+    }
+
+private:
+    // std::string fields are stored as an offset into the string section.
+    template <typename T>
+    using Stored = std::conditional_t<std::same_as<T, std::string>, std::uint64_t, T>;
+
+    using StoredKey = Stored<K>;
+    using StoredValue = Stored<V>;
+
+    struct Record {
+        StoredKey key;
+        StoredValue value;
+    };
+
+    static constexpr std::uint32_t k_flags = (std::same_as<K, std::string> ? detail::k_snapshot_key_is_string : 0u) |
+                                             (std::same_as<V, std::string> ? detail::k_snapshot_value_is_string : 0u);
+    static constexpr std::uint64_t k_section_alignment = 64;
+    static constexpr std::uint64_t k_max_seed_attempts = 16;
+
+    [[nodiscard]] static constexpr std::uint64_t align_up(std::uint64_t offset, std::uint64_t alignment) noexcept {
+        return (offset + alignment - 1) / alignment * alignment;
+    }
+
+    [[nodiscard]] static key_view_type key_view(const K& key) noexcept { return key; }
+
+    [[nodiscard]] static std::uint64_t hash_key(key_view_type key, std::uint64_t seed) noexcept {
+        if constexpr (std::same_as<K, std::string>) {
+            return detail::snapshot_hash(key.data(), key.size(), seed);
+        } else {
+            return detail::snapshot_hash(&key, sizeof(K), seed);
+        }
+    }
+
+    template <typename T>
+    [[nodiscard]] static Stored<T> store(const T& field, std::vector<std::byte>& strings) {
+        if constexpr (std::same_as<T, std::string>) {
+            if (field.size() > UINT32_MAX) {
+                throw std::runtime_error("HashMapSnapshot::write string too long");
+            }
+
+            const std::uint64_t offset = strings.size();
+            const auto length = static_cast<std::uint32_t>(field.size());
+            strings.resize(strings.size() + sizeof(length) + field.size());
+            std::memcpy(strings.data() + offset, &length, sizeof(length));
+            std::memcpy(strings.data() + offset + sizeof(length), field.data(), field.size());
+            return offset;
+        } else {
+            return field;
+        }
+    }
+
+    [[nodiscard]] std::string_view string_at(std::uint64_t offset) const {
+        const std::byte* base = file_.data() + header_.string_offset;
+        const std::uint64_t available = header_.file_size - header_.string_offset;
+        std::uint32_t length = 0;
+        if (offset > available || available - offset < sizeof(length)) {
+            throw std::runtime_error("HashMapSnapshot string offset out of range");
+        }
+
+        std::memcpy(&length, base + offset, sizeof(length));
+        if (available - offset - sizeof(length) < length) {
+            throw std::runtime_error("HashMapSnapshot string length out of range");
+        }
+        return {reinterpret_cast<const char*>(base + offset + sizeof(length)), length};
+    }
+
+    [[nodiscard]] value_view_type value_view(const StoredValue& stored) const {
+        if constexpr (std::same_as<V, std::string>) {
+            return string_at(stored);
+        } else {
+            return stored;
+        }
+    }
+
+    [[nodiscard]] bool key_matches(const StoredKey& stored, key_view_type key) const {
+        if constexpr (std::same_as<K, std::string>) {
+            return string_at(stored) == key;
+        } else {
+            return stored == key;
+        }
+    }
+
+    // The perfect hash sends unknown keys to some slot too, so the stored
+    // key is always compared.
+    [[nodiscard]] std::optional<Record> find_record(key_view_type key) const {
+        if (header_.entry_count == 0) {
+            return std::nullopt;
+        }
+
+        const std::uint64_t hash = hash_key(key, header_.seed);
+        std::uint32_t displacement = 0;
+        std::memcpy(&displacement,
+                    file_.data() + header_.displacement_offset + (hash % header_.bucket_count) * sizeof(std::uint32_t),
+                    sizeof(displacement));
+
+        const std::uint64_t slot = detail::snapshot_slot(hash, displacement, header_.entry_count);
+        if (slot >= header_.entry_count) {
+            return std::nullopt;
+        }
+
+        // memcpy rather than a pointer cast: the mapping holds bytes, not
+        // Record objects, and this compiles to plain loads.
+        Record record;
+        std::memcpy(&record, file_.data() + header_.record_offset + slot * sizeof(Record), sizeof(Record));
+        if (!key_matches(record.key, key)) {
+            return std::nullopt;
+        }
+        return record;
+    }
+
+    detail::MappedFile file_;
+    detail::SnapshotHeader header_;
+};
+
+} // namespace exemplar
@@ -1,6 +1,8 @@
 #include "Heap.h"
 
+#include <memory_resource>
 #include <string>
 
 template class exemplar::Heap<int>;
 template class exemplar::Heap<std::string>;
+template class exemplar::Heap<int, std::less<int>, std::pmr::polymorphic_allocator<int>>;
@@ -2,6 +2,8 @@
 
 #include <cstddef>
 #include <functional>
+#include <memory>
+#include <memory_resource>
 #include <stdexcept>
 #include <utility>
 #include <vector>
@@ -11,11 +13,18 @@ namespace exemplar {
 // A minimal binary heap (array-backed complete binary tree).
 // By default with std::less<T>, this behaves as a min-heap:
 // smaller values have higher priority.
-template <typename T, typename Compare = std::less<T>>
+// The backing array allocates from Allocator.
+template <typename T, typename Compare = std::less<T>, typename Allocator = std::allocator<T>>
 class Heap {
 public:
+    using allocator_type = Allocator;
+
     Heap() = default;
 
+    explicit Heap(const Allocator& alloc) : data_(alloc) {}
+
+    [[nodiscard]] allocator_type get_allocator() const noexcept { return data_.get_allocator(); }
+
     [[nodiscard]] bool empty() const noexcept { return data_.empty(); }
     [[nodiscard]] std::size_t size() const noexcept { return data_.size(); }
 
@@ -97,8 +106,15 @@ private:
         }
     }
 
-    std::vector<T> data_{};
+    std::vector<T, Allocator> data_{};
     Compare compare_{};
 };
 
+namespace pmr {
+
+template <typename T, typename Compare = std::less<T>>
+using Heap = exemplar::Heap<T, Compare, std::pmr::polymorphic_allocator<T>>;
+
+} // namespace pmr
+
 } // namespace exemplar
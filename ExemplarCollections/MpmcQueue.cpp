@@ -0,0 +1,6 @@
+#include "MpmcQueue.h"
+
+#include <string>
+
+template class exemplar::MpmcQueue<int>;
+template class exemplar::MpmcQueue<std::string>;
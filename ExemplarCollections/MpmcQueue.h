@@ -0,0 +1,210 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace exemplar {
+
+// A bounded lock-free FIFO for any number of producer and consumer threads
+// (Dmitry Vyukov's array queue).
+//
+// Every cell of the power-of-two ring carries a sequence number that says
+// whose turn it is. For the cell at position p, sequence == p means it is
+// free for the producer that claims p; sequence == p + 1 means it holds
+// the element for the consumer that claims p. A producer claims a position
+// by compare-exchanging enqueue_pos_, fills the cell, then hands it over
+// with a release store of p + 1; the consumer empties it and hands it back
+// for the next lap with p + capacity. Producers and consumers only contend
+// on their own position counter and never wait on each other except when
+// the queue is full or empty.
+//
+// try_enqueue and try_dequeue never block. enqueue and dequeue wait when
+// the queue is full or empty, spinning briefly and then yielding the core.
+template <typename T>
+class MpmcQueue {
+    static_assert(std::is_nothrow_move_constructible_v<T>, "elements are moved out of claimed cells, which cannot fail");
+
+public:
+    using value_type = T;
+
+    // capacity is rounded up to a power of two.
+    explicit MpmcQueue(std::size_t capacity) : capacity_(rounded_capacity(capacity)), mask_(capacity_ - 1) {
+        cells_ = static_cast<Cell*>(::operator new(capacity_ * sizeof(Cell), std::align_val_t(alignof(Cell))));
+        for (std::size_t i = 0; i < capacity_; ++i) {
+            std::construct_at(cells_ + i, i);
+        }
+    }
+
+    // Every thread holds a reference to the ring.
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+    ~MpmcQueue() {
+        const std::size_t last = enqueue_pos_.load(std::memory_order_relaxed);
+        for (std::size_t position = dequeue_pos_.load(std::memory_order_relaxed); position != last; ++position) {
+            std::destroy_at(cells_[position & mask_].value());
+        }
+        std::destroy(cells_, cells_ + capacity_);
+        ::operator delete(cells_, capacity_ * sizeof(Cell), std::align_val_t(alignof(Cell)));
+    }
+
+    [[nodiscard]] std::size_t capacity() const noexcept { return capacity_; }
+
+    [[nodiscard]] static constexpr std::size_t max_size() noexcept {
+        return std::bit_floor(static_cast<std::size_t>(PTRDIFF_MAX) / sizeof(Cell));
+    }
+
+    // Claimed positions in flight or queued; only a hint while other
+    // threads are running.
+    [[nodiscard]] std::size_t size_approx() const noexcept {
+        const std::size_t dequeued = dequeue_pos_.load(std::memory_order_relaxed);
+        const std::size_t enqueued = enqueue_pos_.load(std::memory_order_relaxed);
+        return enqueued > dequeued ? enqueued - dequeued : 0;
+    }
+
+    // Returns false, leaving value untouched, when the queue is full.
+    bool try_enqueue(const T& value) { return try_emplace(value); }
+    bool try_enqueue(T&& value) { return try_emplace(std::move(value)); }
+
+    // A claimed position must be filled, or its consumer would wait
+    // forever, so an element whose constructor may throw is built before
+    // claiming and then moved into the cell.
+    template <typename... Args>
+    bool try_emplace(Args&&... args) {
+        if constexpr (std::is_nothrow_constructible_v<T, Args&&...>) {
+            const Claim claim = claim_position(enqueue_pos_, 0);
+            if (claim.cell == nullptr) {
+                return false;
+            }
+            std::construct_at(claim.cell->value(), std::forward<Args>(args)...);
+            publish(claim);
+            return true;
+        } else {
+            T value(std::forward<Args>(args)...);
+            return try_emplace(std::move(value));
+        }
+    }
+
+    // Returns false, leaving out untouched, when the queue is empty.
+    bool try_dequeue(T& out) {
+        const Claim claim = claim_position(dequeue_pos_, 1);
+        if (claim.cell == nullptr) {
+            return false;
+        }
+        out = take(claim);
+        return true;
+    }
+
+    // Waits while the queue is full.
+    void enqueue(const T& value) { enqueue(T(value)); }
+
+    void enqueue(T&& value) {
+        for (int spins = 0; !try_enqueue(std::move(value)); ++spins) {
+            back_off(spins);
+        }
+    }
+
+    // Waits while the queue is empty.
+    T dequeue() {
+        for (int spins = 0;; ++spins) {
+            const Claim claim = claim_position(dequeue_pos_, 1);
+            if (claim.cell != nullptr) {
+                return take(claim);
+            }
+            back_off(spins);
+        }
+    }
+
+private:
+    struct Cell {
+        explicit Cell(std::size_t position) noexcept : sequence(position) {}
+
+        [[nodiscard]] T* value() noexcept { return std::launder(reinterpret_cast<T*>(storage)); }
+
+        std::atomic<std::size_t> sequence;
+        alignas(T) std::byte storage[sizeof(T)];
+    };
+
+    static constexpr std::size_t k_cache_line_size = 64;
+
+    // Failed attempts a waiting enqueue or dequeue spins through before it
+    // starts yielding the core.
+    static constexpr int k_spin_limit = 64;
+
+    [[nodiscard]] static std::size_t rounded_capacity(std::size_t capacity) {
+        if (capacity > max_size()) {
+            throw std::length_error("MpmcQueue capacity exceeds max_size");
+        }
+        return std::bit_ceil(std::max<std::size_t>(capacity, 2));
+    }
+
+    struct Claim {
+        Cell* cell;
+        std::size_t position;
+    };
+
+    // Claims the next position of counter (enqueue_pos_ with lag 0, or
+    // dequeue_pos_ with lag 1) whose cell is ready for this side; a null
+    // cell means the queue is full (or empty). The acquire load of the
+    // sequence pairs with the other side's release store, so the cell's
+    // previous contents are fully written (or fully gone).
+    Claim claim_position(std::atomic<std::size_t>& counter, std::size_t lag) noexcept {
+        std::size_t position = counter.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell* cell = cells_ + (position & mask_);
+            const std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const auto turn = static_cast<std::intptr_t>(sequence - (position + lag));
+            if (turn == 0) {
+                // On failure position is reloaded and the loop retries.
+                if (counter.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    return {cell, position};
+                }
+            } else if (turn < 0) {
+                return {nullptr, position};
+            } else {
+                // Another thread claimed position first; catch up.
+                position = counter.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Hands a filled cell to the consumer of its position.
+    void publish(const Claim& claim) noexcept {
+        claim.cell->sequence.store(claim.position + 1, std::memory_order_release);
+    }
+
+    // Empties a claimed cell and hands it to the producer of its next lap.
+    T take(const Claim& claim) noexcept {
+        T* element = claim.cell->value();
+        T out(std::move(*element));
+        std::destroy_at(element);
+        claim.cell->sequence.store(claim.position + capacity_, std::memory_order_release);
+        return out;
+    }
+
+    static void back_off(int spins) {
+        if (spins >= k_spin_limit) {
+            std::this_thread::yield();
+        }
+    }
+
+    const std::size_t capacity_;
+    const std::size_t mask_;
+    Cell* cells_{nullptr};
+
+    // Each counter has its own line: producers hammer one, consumers the
+    // other.
+    alignas(k_cache_line_size) std::atomic<std::size_t> enqueue_pos_{0};
+    alignas(k_cache_line_size) std::atomic<std::size_t> dequeue_pos_{0};
+};
+
+} // namespace exemplar
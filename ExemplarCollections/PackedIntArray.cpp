@@ -0,0 +1,6 @@
+#include "PackedIntArray.h"
+
+#include <cstdint>
+
+template class exemplar::PackedIntArray<std::uint32_t>;
+template class exemplar::PackedIntArray<std::uint64_t>;
@@ -0,0 +1,187 @@
+#pragma once
+
+#include "ResizingArray.h"
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <utility>
+
+namespace exemplar {
+
+// An array of unsigned integers stored in exactly bit_width() bits each,
+// packed back to back in 64-bit words. 20-bit IDs take 20 bits instead of
+// 32, and random access stays O(1): element i starts at bit i * width.
+//
+// The width is fixed at construction; values that do not fit are rejected
+// rather than silently truncated. for_max_value() picks the narrowest
+// width for a known maximum.
+//
+// The words live in a ResizingArray with one spare word at the end, so a
+// read always loads two neighbouring words and never has to branch on
+// whether the value crosses a word boundary.
+template <std::unsigned_integral T = std::uint32_t>
+class PackedIntArray {
+public:
+    using value_type = T;
+
+    explicit PackedIntArray(unsigned bit_width) : bit_width_(bit_width), mask_(mask_for(bit_width)) {
+        if (bit_width == 0 || bit_width > std::numeric_limits<T>::digits) {
+            throw std::invalid_argument("PackedIntArray bit width must be between 1 and the bits of T");
+        }
+        words_.push_back(0);
+    }
+
+    PackedIntArray(const PackedIntArray&) = default;
+    PackedIntArray& operator=(const PackedIntArray&) = default;
+
+    // Leave other empty, as after clear(). Giving it back its spare word
+    // allocates, so a move may throw std::bad_alloc; other is unchanged if
+    // it does.
+    PackedIntArray(PackedIntArray&& other)
+        : words_(std::exchange(other.words_, spare_word())),
+          size_(std::exchange(other.size_, 0)),
+          bit_width_(other.bit_width_),
+          mask_(other.mask_) {}
+
+    PackedIntArray& operator=(PackedIntArray&& other) {
+        if (this != &other) {
+            words_ = std::exchange(other.words_, spare_word());
+            size_ = std::exchange(other.size_, 0);
+            bit_width_ = other.bit_width_;
+            mask_ = other.mask_;
+        }
+        return *this;
+    }
+
+    // The narrowest array that can hold every value up to max_value.
+    [[nodiscard]] static PackedIntArray for_max_value(T max_value) {
+        return PackedIntArray(max_value == 0 ? 1u : static_cast<unsigned>(std::bit_width(max_value)));
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+    [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+    [[nodiscard]] unsigned bit_width() const noexcept { return bit_width_; }
+    [[nodiscard]] T max_value() const noexcept { return static_cast<T>(mask_); }
+
+    // Bytes of word storage allocated, including spare capacity.
+    [[nodiscard]] std::size_t memory_bytes() const noexcept { return words_.capacity() * sizeof(std::uint64_t); }
+
+    T operator[](std::size_t index) const noexcept {
+        const std::size_t bit = index * bit_width_;
+        const std::size_t word = bit / 64;
+        const unsigned offset = bit % 64;
+        const std::uint64_t low = words_[word] >> offset;
+        // Two shifts, because shifting a 64-bit value by 64 is undefined;
+        // at offset 0 this correctly contributes nothing.
+        const std::uint64_t high = (words_[word + 1] << 1) << (63 - offset);
+        return static_cast<T>((low | high) & mask_);
+    }
+
+    T at(std::size_t index) const {
+        if (index >= size_) {
+            throw std::out_of_range("PackedIntArray::at index out of range");
+        }
+        return (*this)[index];
+    }
+
+    void set(std::size_t index, T value) {
+        if (index >= size_) {
+            throw std::out_of_range("PackedIntArray::set index out of range");
+        }
+        store(index, checked(value));
+    }
+
+    void push_back(T value) {
+        const T stored = checked(value);
+        if (words_.size() < words_for(size_ + 1)) {
+            words_.push_back(0);
+        }
+        store(size_, stored);
+        ++size_;
+    }
+
+    void pop_back() {
+        if (empty()) {
+            throw std::runtime_error("PackedIntArray::pop_back on empty container");
+        }
+        store(--size_, 0);
+        if (words_.size() > words_for(size_)) {
+            words_.pop_back();
+        }
+    }
+
+    void clear() noexcept {
+        words_.clear();
+        words_.push_back(0);
+        size_ = 0;
+    }
+
+    void reserve(std::size_t capacity) { words_.reserve(words_for(capacity)); }
+
+    // Unpacks out.size() elements starting at first: one bounds check for
+    // the whole range and a running bit position instead of a multiply.
+    void decode(std::size_t first, std::span<T> out) const {
+        if (first > size_ || out.size() > size_ - first) {
+            throw std::out_of_range("PackedIntArray::decode range out of range");
+        }
+
+        const std::uint64_t* words = words_.data();
+        std::size_t bit = first * bit_width_;
+        for (T& value : out) {
+            const std::size_t word = bit / 64;
+            const unsigned offset = bit % 64;
+            const std::uint64_t high = (words[word + 1] << 1) << (63 - offset);
+            value = static_cast<T>(((words[word] >> offset) | high) & mask_);
+            bit += bit_width_;
+        }
+    }
+
+private:
+    [[nodiscard]] static constexpr std::uint64_t mask_for(unsigned bit_width) noexcept {
+        return bit_width >= 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << bit_width) - 1;
+    }
+
+    // The words of an empty array: just the spare one.
+    [[nodiscard]] static ResizingArray<std::uint64_t> spare_word() {
+        ResizingArray<std::uint64_t> words;
+        words.push_back(0);
+        return words;
+    }
+
+    // Words holding count elements, plus the spare word that reads may touch.
+    [[nodiscard]] std::size_t words_for(std::size_t count) const noexcept {
+        return (count * bit_width_ + 63) / 64 + 1;
+    }
+
+    [[nodiscard]] T checked(T value) const {
+        if (value > mask_) {
+            throw std::out_of_range("PackedIntArray value does not fit in bit_width() bits");
+        }
+        return value;
+    }
+
+    void store(std::size_t index, T value) noexcept {
+        const std::size_t bit = index * bit_width_;
+        const std::size_t word = bit / 64;
+        const unsigned offset = bit % 64;
+        const auto bits = static_cast<std::uint64_t>(value);
+
+        words_[word] = (words_[word] & ~(mask_ << offset)) | (bits << offset);
+        if (offset + bit_width_ > 64) {
+            const unsigned spilled = 64 - offset;
+            words_[word + 1] = (words_[word + 1] & ~(mask_ >> spilled)) | (bits >> spilled);
+        }
+    }
+
+    ResizingArray<std::uint64_t> words_;
+    std::size_t size_{0};
+    unsigned bit_width_;
+    std::uint64_t mask_;
+};
+
+} // namespace exemplar
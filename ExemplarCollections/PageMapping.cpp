@@ -0,0 +1,54 @@
+#include "PageMapping.h"
+
+#include <new>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace exemplar::detail {
+
+#if defined(__linux__)
+
+namespace {
+
+void advise_huge_pages([[maybe_unused]] void* block, [[maybe_unused]] std::size_t bytes) noexcept {
+#if defined(EXEMPLAR_COLLECTIONS_HUGE_PAGES) && defined(MADV_HUGEPAGE)
+    // Advice only: fails harmlessly when THP is disabled or unsupported.
+    ::madvise(block, bytes, MADV_HUGEPAGE);
+#endif
+}
+
+} // namespace
+
+void* map_pages(std::size_t bytes) {
+    void* block = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (block == MAP_FAILED) {
+        throw std::bad_alloc();
+    }
+    advise_huge_pages(block, bytes);
+    return block;
+}
+
+void* remap_pages(void* block, std::size_t old_bytes, std::size_t new_bytes) {
+    void* moved = ::mremap(block, old_bytes, new_bytes, MREMAP_MAYMOVE);
+    if (moved == MAP_FAILED) {
+        throw std::bad_alloc();
+    }
+    advise_huge_pages(moved, new_bytes);
+    return moved;
+}
+
+void unmap_pages(void* block, std::size_t bytes) noexcept { ::munmap(block, bytes); }
+
+#else
+
+void* map_pages(std::size_t) { throw std::bad_alloc(); }
+
+void* remap_pages(void*, std::size_t, std::size_t) { throw std::bad_alloc(); }
+
+void unmap_pages(void*, std::size_t) noexcept {}
+
+#endif
+
+} // namespace exemplar::detail
@@ -0,0 +1,354 @@
+#pragma once
+
+#include "ResizingArray.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace exemplar {
+
+// Data-parallel algorithms over contiguous ranges: a std::span, or a whole
+// ResizingArray. Each call splits its input into chunks and runs them on a
+// ThreadPool (the shared ThreadPool::global() unless one is passed in).
+//
+// Chunk size (the grain) follows the input: at least k_parallel_min_grain
+// elements, so per-chunk overhead stays negligible, and otherwise about
+// k_parallel_chunks_per_thread chunks per thread, so a thread that falls
+// behind does not hold up the others. Inputs of one grain or less run
+// inline on the calling thread.
+//
+// reduce and the scans combine chunk results in chunk order, so op only has
+// to be associative. For floating point the grouping, and so the rounding,
+// depends on the chunking, as with std::reduce.
+
+inline constexpr std::size_t k_parallel_min_grain = 16 * 1024;
+inline constexpr std::size_t k_parallel_chunks_per_thread = 4;
+
+namespace detail {
+
+// Half-open element range of one chunk.
+struct ChunkRange {
+    std::size_t begin;
+    std::size_t end;
+};
+
+class Chunking {
+public:
+    Chunking(std::size_t count, std::size_t thread_count) : count_(count) {
+        const std::size_t target_chunks = thread_count * k_parallel_chunks_per_thread;
+        grain_ = std::max(k_parallel_min_grain, (count + target_chunks - 1) / target_chunks);
+        chunk_count_ = (count + grain_ - 1) / grain_;
+    }
+
+    [[nodiscard]] std::size_t grain() const noexcept { return grain_; }
+    [[nodiscard]] std::size_t chunk_count() const noexcept { return chunk_count_; }
+
+    [[nodiscard]] ChunkRange chunk(std::size_t index) const noexcept {
+        const std::size_t begin = index * grain_;
+        return {begin, std::min(begin + grain_, count_)};
+    }
+
+private:
+    std::size_t count_;
+    std::size_t grain_;
+    std::size_t chunk_count_;
+};
+
+template <typename Array>
+[[nodiscard]] auto as_span(Array& array) noexcept {
+    return std::span(array.data(), array.size());
+}
+
+// Sizes an output array for an algorithm that assigns every element,
+// skipping value-initialization where the type allows it.
+template <typename Array>
+void size_for_overwrite(Array& array, std::size_t size) {
+    if constexpr (requires { array.resize_uninitialized(size); }) {
+        array.resize_uninitialized(size);
+    } else {
+        array.resize(size);
+    }
+}
+
+// Merge path: how many of the first `diagonal` merged outputs of a and b
+// come from a. Ties go to a, matching std::merge.
+template <typename T, typename Compare>
+[[nodiscard]] std::size_t merge_split(std::span<T> a, std::span<T> b, std::size_t diagonal, Compare& comp) {
+    std::size_t low = diagonal > b.size() ? diagonal - b.size() : 0;
+    std::size_t high = std::min(diagonal, a.size());
+    while (low < high) {
+        const std::size_t i = low + (high - low) / 2;
+        if (!comp(b[diagonal - i - 1], a[i])) {
+            low = i + 1;
+        } else {
+            high = i;
+        }
+    }
+    return low;
+}
+
+// One round of a bottom-up merge sort: merges each pair of adjacent sorted
+// runs of length `width` from source into destination. Each pair's output
+// is cut into grain-sized pieces with merge_split, so even the final round,
+// a single pair, keeps every thread busy. All split points are found before
+// any element is moved, since merging moves elements out of source.
+template <typename T, typename Compare>
+void merge_round(std::span<T> source, std::span<T> destination, std::size_t width, std::size_t grain,
+                 ThreadPool& pool, Compare& comp) {
+    const std::size_t count = source.size();
+    const std::size_t pair_width = width * 2;
+    const std::size_t pair_count = (count + pair_width - 1) / pair_width;
+    const std::size_t pieces_per_pair = (pair_width + grain - 1) / grain;
+    const std::size_t task_count = pair_count * pieces_per_pair;
+
+    struct Piece {
+        std::span<T> a;
+        std::span<T> b;
+        std::size_t begin;
+        std::size_t end;
+    };
+
+    auto piece = [&](std::size_t task) {
+        const std::size_t low = task / pieces_per_pair * pair_width;
+        const std::size_t high = std::min(low + pair_width, count);
+        const std::size_t middle = std::min(low + width, count);
+        const std::size_t begin = std::min(low + task % pieces_per_pair * grain, high);
+        return Piece{source.subspan(low, middle - low), source.subspan(middle, high - middle), begin - low,
+                     std::min(begin + grain, high) - low};
+    };
+
+    // a_splits[task]: elements of the pair's first run that precede the piece.
+    std::vector<std::size_t> a_splits(task_count);
+    pool.run(task_count, [&](std::size_t task) {
+        const Piece p = piece(task);
+        a_splits[task] = merge_split(p.a, p.b, p.begin, comp);
+    });
+
+    pool.run(task_count, [&](std::size_t task) {
+        const Piece p = piece(task);
+        if (p.begin == p.end) {
+            return;
+        }
+        const bool last_piece = p.end == p.a.size() + p.b.size();
+        const std::size_t a_begin = a_splits[task];
+        const std::size_t a_end = last_piece ? p.a.size() : a_splits[task + 1];
+        const std::size_t b_begin = p.begin - a_begin;
+        const std::size_t b_end = p.end - a_end;
+
+        std::merge(std::make_move_iterator(p.a.begin() + a_begin), std::make_move_iterator(p.a.begin() + a_end),
+                   std::make_move_iterator(p.b.begin() + b_begin), std::make_move_iterator(p.b.begin() + b_end),
+                   destination.begin() + (p.a.data() - source.data()) + p.begin, comp);
+    });
+}
+
+// Sorts one run per thread with std::sort, then merges runs pairwise,
+// ping-ponging between data and buffer.
+template <typename T, typename Compare>
+void sort_with_buffer(std::span<T> data, std::span<T> buffer, ThreadPool& pool, Compare& comp) {
+    const std::size_t count = data.size();
+    const std::size_t run_count = std::min(pool.thread_count(), count / k_parallel_min_grain);
+    std::size_t width = (count + run_count - 1) / run_count;
+    pool.run(run_count, [&](std::size_t index) {
+        const std::size_t begin = std::min(index * width, count);
+        const std::size_t end = std::min(begin + width, count);
+        std::sort(data.begin() + begin, data.begin() + end, comp);
+    });
+
+    const std::size_t grain = Chunking(count, pool.thread_count()).grain();
+    std::span<T> source = data;
+    std::span<T> destination = buffer;
+    for (; width < count; width *= 2) {
+        merge_round(source, destination, width, grain, pool, comp);
+        std::swap(source, destination);
+    }
+
+    if (source.data() != data.data()) {
+        const Chunking chunking(count, pool.thread_count());
+        pool.run(chunking.chunk_count(), [&](std::size_t index) {
+            const ChunkRange range = chunking.chunk(index);
+            std::move(source.begin() + range.begin, source.begin() + range.end, data.begin() + range.begin);
+        });
+    }
+}
+
+// Shared by the inclusive and exclusive scans. Pass 1 totals every chunk
+// but the last in parallel; a short serial pass turns the totals into each
+// chunk's starting value; pass 2 rescans every chunk from its starting
+// value in parallel. Every input element is read before the matching
+// output element is written, so input and output may be the same range.
+template <bool Inclusive, typename T, typename U, typename Op>
+void scan(std::span<T> input, std::span<U> output, std::optional<U> init, Op& op, ThreadPool& pool) {
+    if (output.size() != input.size()) {
+        throw std::invalid_argument("parallel scan output size does not match input size");
+    }
+
+    const Chunking chunking(input.size(), pool.thread_count());
+    const std::size_t chunk_count = chunking.chunk_count();
+    if (chunk_count == 0) {
+        return;
+    }
+
+    // starts[i] is folded in before chunk i's elements; empty only for an
+    // inclusive scan's first chunk.
+    std::vector<std::optional<U>> starts(chunk_count);
+    starts[0] = std::move(init);
+    pool.run(chunk_count - 1, [&](std::size_t index) {
+        const ChunkRange range = chunking.chunk(index);
+        U total = input[range.begin];
+        for (std::size_t i = range.begin + 1; i < range.end; ++i) {
+            total = op(std::move(total), input[i]);
+        }
+        starts[index + 1] = std::move(total);
+    });
+
+    for (std::size_t index = 1; index < chunk_count; ++index) {
+        if (starts[index - 1]) {
+            starts[index] = op(*starts[index - 1], std::move(*starts[index]));
+        }
+    }
+
+    pool.run(chunk_count, [&](std::size_t index) {
+        const ChunkRange range = chunking.chunk(index);
+        std::size_t i = range.begin;
+        const bool has_start = starts[index].has_value();
+        U carry = has_start ? std::move(*starts[index]) : U(input[i++]);
+        if (!has_start) {
+            output[range.begin] = carry;
+        }
+
+        for (; i < range.end; ++i) {
+            if constexpr (Inclusive) {
+                carry = op(std::move(carry), input[i]);
+                output[i] = carry;
+            } else {
+                U value = input[i];
+                output[i] = carry;
+                carry = op(std::move(carry), std::move(value));
+            }
+        }
+    });
+}
+
+} // namespace detail
+
+// Calls fn(i) for every i in [0, count).
+template <typename Fn>
+void parallel_for(std::size_t count, Fn&& fn, ThreadPool& pool = ThreadPool::global()) {
+    const detail::Chunking chunking(count, pool.thread_count());
+    pool.run(chunking.chunk_count(), [&](std::size_t index) {
+        const detail::ChunkRange range = chunking.chunk(index);
+        for (std::size_t i = range.begin; i < range.end; ++i) {
+            fn(i);
+        }
+    });
+}
+
+// output[i] = op(input[i]). output may be the same range as input.
+template <typename T, typename U, typename Op>
+void parallel_transform(std::span<T> input, std::span<U> output, Op op, ThreadPool& pool = ThreadPool::global()) {
+    if (output.size() != input.size()) {
+        throw std::invalid_argument("parallel_transform output size does not match input size");
+    }
+    parallel_for(input.size(), [&](std::size_t i) { output[i] = op(input[i]); }, pool);
+}
+
+// Folds init and every element with op, which must be associative.
+template <typename T, typename Op = std::plus<>>
+[[nodiscard]] std::remove_cv_t<T> parallel_reduce(std::span<T> input, std::remove_cv_t<T> init, Op op = {},
+                                                  ThreadPool& pool = ThreadPool::global()) {
+    using Value = std::remove_cv_t<T>;
+
+    const detail::Chunking chunking(input.size(), pool.thread_count());
+    std::vector<std::optional<Value>> partials(chunking.chunk_count());
+    pool.run(chunking.chunk_count(), [&](std::size_t index) {
+        const detail::ChunkRange range = chunking.chunk(index);
+        Value total = input[range.begin];
+        for (std::size_t i = range.begin + 1; i < range.end; ++i) {
+            total = op(std::move(total), input[i]);
+        }
+        partials[index] = std::move(total);
+    });
+
+    for (auto& partial : partials) {
+        init = op(std::move(init), std::move(*partial));
+    }
+    return init;
+}
+
+// output[i] = input[0] op input[1] op ... op input[i].
+template <typename T, typename U, typename Op = std::plus<>>
+void parallel_inclusive_scan(std::span<T> input, std::span<U> output, Op op = {},
+                             ThreadPool& pool = ThreadPool::global()) {
+    detail::scan<true>(input, output, std::optional<U>(), op, pool);
+}
+
+// output[0] = init, output[i] = init op input[0] op ... op input[i - 1].
+template <typename T, typename U, typename Op = std::plus<>>
+void parallel_exclusive_scan(std::span<T> input, std::span<U> output, U init, Op op = {},
+                             ThreadPool& pool = ThreadPool::global()) {
+    detail::scan<false>(input, output, std::optional<U>(std::move(init)), op, pool);
+}
+
+// Sorts with comp; not stable. Needs a scratch buffer of data.size()
+// elements.
+template <typename T, typename Compare = std::less<>>
+void parallel_sort(std::span<T> data, Compare comp = {}, ThreadPool& pool = ThreadPool::global()) {
+    if (pool.thread_count() == 1 || data.size() < 2 * k_parallel_min_grain) {
+        std::sort(data.begin(), data.end(), comp);
+        return;
+    }
+
+    if constexpr (std::is_trivially_default_constructible_v<T> && std::is_trivially_destructible_v<T>) {
+        ResizingArray<T> buffer;
+        buffer.resize_uninitialized(data.size());
+        detail::sort_with_buffer(data, detail::as_span(buffer), pool, comp);
+    } else {
+        std::vector<T> buffer(data.size());
+        detail::sort_with_buffer(data, std::span<T>(buffer), pool, comp);
+    }
+}
+
+// ResizingArray overloads. Output arrays are resized to the input's size.
+
+template <typename T, typename A, typename SA, typename U, typename B, typename SB, typename Op>
+void parallel_transform(const ResizingArray<T, A, SA>& input, ResizingArray<U, B, SB>& output, Op op,
+                        ThreadPool& pool = ThreadPool::global()) {
+    detail::size_for_overwrite(output, input.size());
+    parallel_transform(detail::as_span(input), detail::as_span(output), std::move(op), pool);
+}
+
+template <typename T, typename A, typename SA, typename Op = std::plus<>>
+[[nodiscard]] T parallel_reduce(const ResizingArray<T, A, SA>& input, T init, Op op = {},
+                                ThreadPool& pool = ThreadPool::global()) {
+    return parallel_reduce(detail::as_span(input), std::move(init), std::move(op), pool);
+}
+
+template <typename T, typename A, typename SA, typename U, typename B, typename SB, typename Op = std::plus<>>
+void parallel_inclusive_scan(const ResizingArray<T, A, SA>& input, ResizingArray<U, B, SB>& output, Op op = {},
+                             ThreadPool& pool = ThreadPool::global()) {
+    detail::size_for_overwrite(output, input.size());
+    parallel_inclusive_scan(detail::as_span(input), detail::as_span(output), std::move(op), pool);
+}
+
+template <typename T, typename A, typename SA, typename U, typename B, typename SB, typename Op = std::plus<>>
+void parallel_exclusive_scan(const ResizingArray<T, A, SA>& input, ResizingArray<U, B, SB>& output, U init, Op op = {},
+                             ThreadPool& pool = ThreadPool::global()) {
+    detail::size_for_overwrite(output, input.size());
+    parallel_exclusive_scan(detail::as_span(input), detail::as_span(output), std::move(init), std::move(op), pool);
+}
+
+template <typename T, typename A, typename SA, typename Compare = std::less<>>
+void parallel_sort(ResizingArray<T, A, SA>& data, Compare comp = {}, ThreadPool& pool = ThreadPool::global()) {
+    parallel_sort(detail::as_span(data), std::move(comp), pool);
+}
+
+} // namespace exemplar
@@ -1,6 +1,8 @@
 #include "Queue.h"
 
+#include <memory_resource>
 #include <string>
 
 template class exemplar::Queue<int>;
 template class exemplar::Queue<std::string>;
+template class exemplar::Queue<std::pmr::string, std::pmr::polymorphic_allocator<std::pmr::string>>;
@@ -1,6 +1,10 @@
 #pragma once
 
+#include "AllocatorSupport.h"
+
 #include <cstddef>
+#include <memory>
+#include <memory_resource>
 #include <stdexcept>
 #include <utility>
 
@@ -8,14 +12,30 @@ namespace exemplar {
 
 // A FIFO queue implemented with a singly linked chain.
 // Enqueue at tail, dequeue at head: both O(1).
-template <typename T>
+//
+// Nodes come from Allocator (rebound to the node type). With a std::pmr
+// allocator the elements are constructed with it too, so e.g. a
+// pmr::Queue<std::pmr::string> keeps all of its memory in one resource.
+template <typename T, typename Allocator = std::allocator<T>>
 class Queue {
 public:
+    using allocator_type = Allocator;
+
     Queue() = default;
 
-    Queue(const Queue& other) {
-        for (Node* cursor = other.head_; cursor != nullptr; cursor = cursor->next) {
-            enqueue(cursor->value);
+    explicit Queue(const Allocator& alloc) noexcept : node_alloc_(alloc) {}
+
+    Queue(const Queue& other)
+        : Queue(other, std::allocator_traits<Allocator>::select_on_container_copy_construction(other.get_allocator())) {}
+
+    Queue(const Queue& other, const Allocator& alloc) : node_alloc_(alloc) {
+        try {
+            for (Node* cursor = other.head_; cursor != nullptr; cursor = cursor->next) {
+                enqueue(cursor->value);
+            }
+        } catch (...) {
+            clear();
+            throw;
         }
     }
 
@@ -24,41 +44,62 @@ public:
             return *this;
         }
 
-        Queue copy(other);
-        swap(copy);
+        Queue copy(other, detail::propagate_on_copy_assignment_v<Allocator> ? other.get_allocator() : get_allocator());
+        if constexpr (detail::propagate_on_copy_assignment_v<Allocator>) {
+            std::swap(node_alloc_, copy.node_alloc_);
+        }
+        swap_nodes(copy);
         return *this;
     }
 
-    Queue(Queue&& other) noexcept : head_(other.head_), tail_(other.tail_), size_(other.size_) {
-        other.head_ = nullptr;
-        other.tail_ = nullptr;
-        other.size_ = 0;
+    Queue(Queue&& other) noexcept : node_alloc_(std::move(other.node_alloc_)) { swap_nodes(other); }
+
+    // Moves element by element when alloc cannot free other's nodes.
+    Queue(Queue&& other, const Allocator& alloc) : node_alloc_(alloc) {
+        if (node_alloc_ == other.node_alloc_) {
+            swap_nodes(other);
+            return;
+        }
+
+        try {
+            for (Node* cursor = other.head_; cursor != nullptr; cursor = cursor->next) {
+                enqueue(std::move(cursor->value));
+            }
+        } catch (...) {
+            clear();
+            throw;
+        }
     }
 
-    Queue& operator=(Queue&& other) noexcept {
+    Queue& operator=(Queue&& other) noexcept(detail::nothrow_move_assignable_v<Allocator>) {
         if (this == &other) {
             return *this;
         }
 
-        clear();
-        head_ = other.head_;
-        tail_ = other.tail_;
-        size_ = other.size_;
-
-        other.head_ = nullptr;
-        other.tail_ = nullptr;
-        other.size_ = 0;
-
+        if constexpr (detail::propagate_on_move_assignment_v<Allocator>) {
+            clear();
+            node_alloc_ = std::move(other.node_alloc_);
+            swap_nodes(other);
+        } else if (node_alloc_ == other.node_alloc_) {
+            clear();
+            swap_nodes(other);
+        } else {
+            Queue moved(std::move(other), get_allocator());
+            clear();
+            swap_nodes(moved);
+        }
         return *this;
     }
 
     ~Queue() { clear(); }
 
+    [[nodiscard]] allocator_type get_allocator() const noexcept { return allocator_type(node_alloc_); }
+
     [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
     [[nodiscard]] std::size_t size() const noexcept { return size_; }
 
-    void enqueue(const T& value) { link_back(new Node(value)); }
-    void enqueue(T&& value) { link_back(new Node(std::move(value))); }
+    void enqueue(const T& value) { link_back(detail::new_node(node_alloc_, get_allocator(), value)); }
+    void enqueue(T&& value) { link_back(detail::new_node(node_alloc_, get_allocator(), std::move(value))); }
 
     void dequeue() {
         if (empty()) {
@@ -67,7 +108,7 @@ public:
 
         Node* old_head = head_;
         head_ = head_->next;
-        delete old_head;
+        detail::delete_node(node_alloc_, old_head);
         --size_;
 
         if (size_ == 0) {
@@ -107,7 +148,7 @@ public:
         Node* cursor = head_;
         while (cursor != nullptr) {
             Node* next = cursor->next;
-            delete cursor;
+            detail::delete_node(node_alloc_, cursor);
             cursor = next;
         }
 
@@ -116,21 +157,27 @@ public:
         size_ = 0;
     }
 
+    // As with the std containers, swapping queues whose allocators differ
+    // and do not propagate on swap is undefined.
     void swap(Queue& other) noexcept {
-        std::swap(head_, other.head_);
-        std::swap(tail_, other.tail_);
-        std::swap(size_, other.size_);
+        if constexpr (detail::propagate_on_swap_v<Allocator>) {
+            std::swap(node_alloc_, other.node_alloc_);
+        }
+        swap_nodes(other);
     }
 
 private:
     struct Node {
-        explicit Node(const T& v) : value(v) {}
-        explicit Node(T&& v) : value(std::move(v)) {}
+        template <typename... Args>
+        explicit Node(const Allocator& alloc, Args&&... args)
+            : value(std::make_obj_using_allocator<T>(alloc, std::forward<Args>(args)...)) {}
 
         T value;
         Node* next{nullptr};
     };
 
+    using NodeAllocator = detail::rebind_alloc_t<Allocator, Node>;
+
     void link_back(Node* node) {
         if (tail_ == nullptr) {
             head_ = node;
@@ -143,14 +190,28 @@ private:
         ++size_;
     }
 
+    void swap_nodes(Queue& other) noexcept {
+        std::swap(head_, other.head_);
+        std::swap(tail_, other.tail_);
+        std::swap(size_, other.size_);
+    }
+
+    [[no_unique_address]] NodeAllocator node_alloc_{};
     Node* head_{nullptr};
     Node* tail_{nullptr};
     std::size_t size_{0};
 };
 
-template <typename T>
-void swap(Queue<T>& left, Queue<T>& right) noexcept {
+template <typename T, typename Allocator>
+void swap(Queue<T, Allocator>& left, Queue<T, Allocator>& right) noexcept {
     left.swap(right);
 }
 
+namespace pmr {
+
+template <typename T>
+using Queue = exemplar::Queue<T, std::pmr::polymorphic_allocator<T>>;
+
+} // namespace pmr
+
 } // namespace exemplar
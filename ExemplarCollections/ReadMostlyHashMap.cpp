@@ -0,0 +1,6 @@
+#include "ReadMostlyHashMap.h"
+
+#include <string>
+
+template class exemplar::ReadMostlyHashMap<int, int>;
+template class exemplar::ReadMostlyHashMap<std::string, int>;
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "EpochReclamation.h"
+#include "HashMap.h"
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace exemplar {
+
+// A hash map for data that is read constantly and changed rarely
+// (configuration, routing tables).
+//
+// Readers never lock: they load a pointer to an immutable HashMap inside an
+// EpochGuard and search it. Writers are serialized by a mutex; each write
+// copies the current table, changes the copy and publishes it with one
+// atomic pointer store (read-copy-update). The replaced table is handed to
+// epoch-based reclamation and freed once no reader can still be using it.
+//
+// A write costs O(n). Use update() to apply several changes with one copy.
+template <typename K, typename V, typename Hash = std::hash<K>>
+class ReadMostlyHashMap {
+public:
+    using Map = HashMap<K, V, Hash>;
+
+    // Creating the global domain first means it is destroyed after any
+    // map with static storage duration, whose destructor still uses it.
+    ReadMostlyHashMap() : current_(new Map()) { EpochDomain::global(); }
+
+    ReadMostlyHashMap(const ReadMostlyHashMap&) = delete;
+    ReadMostlyHashMap& operator=(const ReadMostlyHashMap&) = delete;
+
+    // The caller must ensure no other thread is still using the map. Tables
+    // retired by earlier writes are freed here too unless a reader of some
+    // other structure still holds an older epoch; those go when a later
+    // retire() or the domain's destructor runs.
+    ~ReadMostlyHashMap() {
+        delete current_.load(std::memory_order_relaxed);
+        EpochDomain::global().try_reclaim();
+    }
+
+    [[nodiscard]] std::size_t size() const {
+        return read([](const Map& map) { return map.size(); });
+    }
+
+    [[nodiscard]] bool empty() const { return size() == 0; }
+
+    [[nodiscard]] bool contains(const K& key) const {
+        return read([&](const Map& map) { return map.contains(key); });
+    }
+
+    std::optional<V> get(const K& key) const {
+        return read([&](const Map& map) { return map.get(key); });
+    }
+
+    // Runs fn(const Map&) against one consistent version of the table, e.g.
+    // to do several lookups without re-entering the read side each time.
+    // fn must not keep references into the map after it returns, and may not
+    // return one: the table can be reclaimed as soon as the guard is gone.
+    template <typename Fn>
+    auto read(Fn&& fn) const {
+        static_assert(!std::is_reference_v<std::invoke_result_t<Fn, const Map&>>,
+                      "ReadMostlyHashMap::read callback must return by value");
+        EpochGuard guard;
+        return std::invoke(std::forward<Fn>(fn), *current_.load(std::memory_order_acquire));
+    }
+
+    bool insert_or_assign(const K& key, const V& value) {
+        return update([&](Map& map) { return map.insert_or_assign(key, value); });
+    }
+
+    bool erase(const K& key) {
+        return update([&](Map& map) { return map.erase(key); });
+    }
+
+    // Applies fn(Map&) to a private copy of the table and publishes the
+    // result atomically: readers see either none or all of fn's changes.
+    template <typename Fn>
+    auto update(Fn&& fn) {
+        std::lock_guard lock(writer_mutex_);
+        auto next_map = std::make_unique<Map>(*current_.load(std::memory_order_relaxed));
+
+        if constexpr (std::is_void_v<std::invoke_result_t<Fn, Map&>>) {
+            std::invoke(std::forward<Fn>(fn), *next_map);
+            publish(std::move(next_map));
+        } else {
+            auto result = std::invoke(std::forward<Fn>(fn), *next_map);
+            publish(std::move(next_map));
+            return result;
+        }
+    }
+
+private:
+    // Called with writer_mutex_ held.
+    void publish(std::unique_ptr<Map> next_map) {
+        const Map* old_map = current_.exchange(next_map.release(), std::memory_order_seq_cst);
+        EpochDomain::global().retire([old_map] { delete old_map; });
+    }
+
+    std::atomic<const Map*> current_;
+    std::mutex writer_mutex_;
+};
+
+} // namespace exemplar
@@ -1,5 +1,6 @@
 #include "ResizingArray.h"
 
+#include <memory_resource>
 #include <string>
 
 // Template note:
@@ -9,3 +10,5 @@
 
 template class exemplar::ResizingArray<int>;
 template class exemplar::ResizingArray<std::string>;
+template class exemplar::ResizingArray<std::pmr::string, std::pmr::polymorphic_allocator<std::pmr::string>>;
+template class exemplar::ResizingArray<int, std::allocator<int>, exemplar::CountingStats>;
@@ -1,9 +1,19 @@
 #pragma once
 
+#include "AllocatorSupport.h"
+#include "ContainerStats.h"
+#include "PageMapping.h"
+
 #include <algorithm>
 #include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <memory>
+#include <memory_resource>
+#include <new>
 #include <stdexcept>
+#include <type_traits>
 #include <utility>
 
 namespace exemplar {
@@ -14,25 +24,52 @@ namespace exemplar {
 // - move-aware growth
 // - amortized O(1) push_back
 //
+// Storage is raw memory: slots past size() hold no objects, so growing
+// constructs nothing and only the elements that exist are moved.
+// Trivially copyable types are relocated with realloc, which can often grow
+// the block in place (or, for large blocks, by remapping pages).
+//
+// Memory comes from Allocator, and elements are constructed through it, so
+// a std::pmr allocator is passed on to allocator-aware elements. The
+// realloc path is only taken with the default std::allocator.
+//
+// On Linux, blocks of trivially copyable elements from
+// k_page_mapping_threshold_bytes up are anonymous page mappings instead
+// (see PageMapping.h): growth is an mremap, which remaps pages rather than
+// copying them, and the memory can be backed by transparent huge pages.
+//
+// Stats is a policy from ContainerStats.h that counts allocations, growths
+// and bytes moved; the default NoStats compiles away.
+//
 // This class intentionally keeps the API compact and readable.
-template <typename T>
+template <typename T, typename Allocator = std::allocator<T>, typename Stats = NoStats>
 class ResizingArray {
 public:
+    using allocator_type = Allocator;
+
     ResizingArray() = default;
 
-    explicit ResizingArray(std::size_t initial_capacity)
-        : data_(initial_capacity ? std::make_unique<T[]>(initial_capacity) : nullptr),
-          size_(0),
-          capacity_(initial_capacity) {}
+    explicit ResizingArray(const Allocator& alloc) noexcept : alloc_(alloc) {}
 
-    // Rule-of-5 for a resource-owning type.
+    explicit ResizingArray(std::size_t initial_capacity, const Allocator& alloc = Allocator()) : alloc_(alloc) {
+        reserve(initial_capacity);
+    }
+
+    // Rule-of-5 for a resource-owning type, plus the allocator-extended
+    // copy and move constructors.
     ResizingArray(const ResizingArray& other)
-        : data_(other.capacity_ ? std::make_unique<T[]>(other.capacity_) : nullptr),
-          size_(other.size_),
-          capacity_(other.capacity_) {
-        for (std::size_t i = 0; i < size_; ++i) {
-            data_[i] = other.data_[i];
+        : ResizingArray(other, AllocTraits::select_on_container_copy_construction(other.alloc_)) {}
+
+    ResizingArray(const ResizingArray& other, const Allocator& alloc) : alloc_(alloc) {
+        data_ = allocate(other.size_);
+        capacity_ = other.size_;
+        try {
+            construct_from<false>(data_, other.data_, other.size_);
+        } catch (...) {
+            deallocate(data_, capacity_);
+            throw;
         }
+        size_ = other.size_;
     }
 
     ResizingArray& operator=(const ResizingArray& other) {
@@ -40,19 +77,75 @@ public:
             return *this;
         }
 
-        ResizingArray copy(other);
-        swap(copy);
+        ResizingArray copy(other, detail::propagate_on_copy_assignment_v<Allocator> ? other.alloc_ : alloc_);
+        if constexpr (detail::propagate_on_copy_assignment_v<Allocator>) {
+            std::swap(alloc_, copy.alloc_);
+        }
+        swap_storage(copy);
+        return *this;
+    }
+
+    ResizingArray(ResizingArray&& other) noexcept : alloc_(std::move(other.alloc_)) { swap_storage(other); }
+
+    // Moves element by element when alloc cannot free other's block.
+    ResizingArray(ResizingArray&& other, const Allocator& alloc) : alloc_(alloc) {
+        if (alloc_ == other.alloc_) {
+            swap_storage(other);
+            return;
+        }
+
+        data_ = allocate(other.size_);
+        capacity_ = other.size_;
+        try {
+            construct_from<true>(data_, other.data_, other.size_);
+        } catch (...) {
+            deallocate(data_, capacity_);
+            throw;
+        }
+        size_ = other.size_;
+    }
+
+    ResizingArray& operator=(ResizingArray&& other) noexcept(detail::nothrow_move_assignable_v<Allocator>) {
+        if (this == &other) {
+            return *this;
+        }
+
+        if constexpr (detail::propagate_on_move_assignment_v<Allocator>) {
+            release_storage();
+            alloc_ = std::move(other.alloc_);
+            swap_storage(other);
+        } else if (alloc_ == other.alloc_) {
+            release_storage();
+            swap_storage(other);
+        } else {
+            ResizingArray moved(std::move(other), alloc_);
+            release_storage();
+            swap_storage(moved);
+        }
         return *this;
     }
 
-    ResizingArray(ResizingArray&&) noexcept = default;
-    ResizingArray& operator=(ResizingArray&&) noexcept = default;
-    ~ResizingArray() = default;
+    ~ResizingArray() { release_storage(); }
+
+    [[nodiscard]] allocator_type get_allocator() const noexcept { return alloc_; }
+
+    [[nodiscard]] const Stats& stats() const noexcept { return stats_; }
+    void reset_stats() noexcept { stats_ = Stats(); }
 
     [[nodiscard]] std::size_t size() const noexcept { return size_; }
     [[nodiscard]] std::size_t capacity() const noexcept { return capacity_; }
     [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
 
+    [[nodiscard]] static constexpr std::size_t max_size() noexcept { return PTRDIFF_MAX / sizeof(T); }
+
+    // Blocks at least this large are page mappings, when that path applies
+    // to T (trivially copyable, default allocator, Linux). Below it, a
+    // mapping would waste up to a page and a system call per growth.
+    static constexpr std::size_t k_page_mapping_threshold_bytes = std::size_t{64} << 20;
+
+    T* data() noexcept { return data_; }
+    const T* data() const noexcept { return data_; }
+
     T& operator[](std::size_t index) noexcept { return data_[index]; }
     const T& operator[](std::size_t index) const noexcept { return data_[index]; }
 
@@ -98,70 +191,324 @@ public:
         return data_[size_ - 1];
     }
 
-    void push_back(const T& value) {
-        ensure_capacity_for_one_more();
-        data_[size_++] = value;
-    }
+    void push_back(const T& value) { emplace_back(value); }
 
-    void push_back(T&& value) {
-        ensure_capacity_for_one_more();
-        data_[size_++] = std::move(value);
-    }
+    void push_back(T&& value) { emplace_back(std::move(value)); }
 
     template <typename... Args>
     T& emplace_back(Args&&... args) {
-        ensure_capacity_for_one_more();
-        data_[size_] = T(std::forward<Args>(args)...);
-        return data_[size_++];
+        if (size_ == capacity_) {
+            return grow_and_emplace_back(std::forward<Args>(args)...);
+        }
+
+        T* element = data_ + size_;
+        AllocTraits::construct(alloc_, element, std::forward<Args>(args)...);
+        ++size_;
+        return *element;
     }
 
     void pop_back() {
         if (empty()) {
             throw std::runtime_error("ResizingArray::pop_back on empty container");
         }
-        --size_;
+        AllocTraits::destroy(alloc_, data_ + --size_);
     }
 
-    void clear() noexcept { size_ = 0; }
+    void clear() noexcept {
+        destroy_range(data_, data_ + size_);
+        size_ = 0;
+    }
 
     void reserve(std::size_t new_capacity) {
         if (new_capacity <= capacity_) {
             return;
         }
 
-        auto new_data = std::make_unique<T[]>(new_capacity);
-        for (std::size_t i = 0; i < size_; ++i) {
-            new_data[i] = std::move(data_[i]);
+        reallocate(new_capacity);
+    }
+
+    // Shrinks to new_size, or grows with value-initialized elements
+    // (zero for arithmetic types).
+    void resize(std::size_t new_size) {
+        if (new_size <= size_) {
+            destroy_range(data_ + new_size, data_ + size_);
+            size_ = new_size;
+            return;
         }
 
-        data_ = std::move(new_data);
-        capacity_ = new_capacity;
+        reserve(new_size);
+        std::size_t built = size_;
+        try {
+            for (; built < new_size; ++built) {
+                AllocTraits::construct(alloc_, data_ + built);
+            }
+        } catch (...) {
+            destroy_range(data_ + size_, data_ + built);
+            throw;
+        }
+        size_ = new_size;
+    }
+
+    // Like resize, but new elements are left default-initialized, i.e. with
+    // indeterminate values. For bulk fills that overwrite every element
+    // through data() anyway: it saves the pass that zeroes them first.
+    void resize_uninitialized(std::size_t new_size)
+        requires std::is_trivially_default_constructible_v<T> && std::is_trivially_destructible_v<T>
+    {
+        reserve(new_size);
+        if (new_size > size_) {
+            // Default-initializing a trivial type does nothing, so there is no
+            // allocator construct() call to make.
+            std::uninitialized_default_construct(data_ + size_, data_ + new_size);
+        }
+        size_ = new_size;
     }
 
+    // As with the std containers, swapping arrays whose allocators differ
+    // and do not propagate on swap is undefined.
     void swap(ResizingArray& other) noexcept {
+        if constexpr (detail::propagate_on_swap_v<Allocator>) {
+            std::swap(alloc_, other.alloc_);
+        }
+        swap_storage(other);
+    }
+
+private:
+    using AllocTraits = std::allocator_traits<Allocator>;
+
+    static_assert(std::is_same_v<typename AllocTraits::pointer, T*>, "fancy allocator pointers are not supported");
+
+    // Types that can be moved with memcpy and need no destructor call, so a
+    // block of them can be handed to realloc. Over-aligned types are excluded
+    // because malloc only guarantees alignof(std::max_align_t), and custom
+    // allocators because realloc only works on malloc's own blocks.
+    static constexpr bool k_relocate_with_realloc = std::is_same_v<Allocator, std::allocator<T>> &&
+                                                    std::is_trivially_copyable_v<T> &&
+                                                    alignof(T) <= alignof(std::max_align_t);
+
+    static constexpr bool k_grow_with_page_mapping = k_relocate_with_realloc && detail::k_page_mapping_supported;
+
+    // Whether a block of capacity elements is a page mapping rather than a
+    // malloc block. It depends only on the capacity, so deallocate() and
+    // reallocate() can tell which kind of block they were given.
+    [[nodiscard]] static constexpr bool is_page_mapped(std::size_t capacity) noexcept {
+        if constexpr (k_grow_with_page_mapping) {
+            return capacity >= k_page_mapping_threshold_bytes / sizeof(T);
+        } else {
+            return false;
+        }
+    }
+
+    [[nodiscard]] T* allocate(std::size_t capacity) {
+        if (capacity == 0) {
+            return nullptr;
+        }
+
+        if (capacity > max_size()) {
+            throw std::length_error("ResizingArray capacity exceeds max_size");
+        }
+
+        T* data = nullptr;
+        if (is_page_mapped(capacity)) {
+            data = static_cast<T*>(detail::map_pages(capacity * sizeof(T)));
+        } else if constexpr (k_relocate_with_realloc) {
+            data = static_cast<T*>(std::malloc(capacity * sizeof(T)));
+            if (data == nullptr) {
+                throw std::bad_alloc();
+            }
+        } else {
+            data = AllocTraits::allocate(alloc_, capacity);
+        }
+        stats_.on_allocation(capacity * sizeof(T));
+        return data;
+    }
+
+    void deallocate(T* data, std::size_t capacity) noexcept {
+        if (data == nullptr) {
+            return;
+        }
+
+        if (is_page_mapped(capacity)) {
+            detail::unmap_pages(data, capacity * sizeof(T));
+        } else if constexpr (k_relocate_with_realloc) {
+            std::free(data);
+        } else {
+            AllocTraits::deallocate(alloc_, data, capacity);
+        }
+    }
+
+    void destroy_range(T* first, T* last) noexcept {
+        for (; first != last; ++first) {
+            AllocTraits::destroy(alloc_, first);
+        }
+    }
+
+    // Destroys the elements and frees the block, leaving the array empty
+    // with no storage.
+    void release_storage() noexcept {
+        destroy_range(data_, data_ + size_);
+        deallocate(data_, capacity_);
+        data_ = nullptr;
+        size_ = 0;
+        capacity_ = 0;
+    }
+
+    void swap_storage(ResizingArray& other) noexcept {
         std::swap(data_, other.data_);
         std::swap(size_, other.size_);
         std::swap(capacity_, other.capacity_);
     }
 
-private:
-    void ensure_capacity_for_one_more() {
-        if (size_ < capacity_) {
-            return;
+    // Constructs count elements at dest from source (moved when Move)
+    // through the allocator. On exception, destroys the ones it built.
+    template <bool Move>
+    void construct_from(T* dest, T* source, std::size_t count) {
+        std::size_t built = 0;
+        try {
+            for (; built < count; ++built) {
+                if constexpr (Move) {
+                    AllocTraits::construct(alloc_, dest + built, std::move(source[built]));
+                } else {
+                    AllocTraits::construct(alloc_, dest + built, std::as_const(source[built]));
+                }
+            }
+        } catch (...) {
+            destroy_range(dest, dest + built);
+            throw;
+        }
+    }
+
+    // Moves the elements into storage for new_capacity >= size_ elements.
+    // Strong guarantee: if anything throws, the array is unchanged.
+    void reallocate(std::size_t new_capacity) {
+        if constexpr (k_relocate_with_realloc) {
+            if (new_capacity > max_size()) {
+                throw std::length_error("ResizingArray capacity exceeds max_size");
+            }
+
+            if constexpr (k_grow_with_page_mapping) {
+                if (is_page_mapped(new_capacity)) {
+                    reallocate_page_mapped(new_capacity);
+                    return;
+                }
+            }
+
+            void* block = std::realloc(data_, new_capacity * sizeof(T));
+            if (block == nullptr) {
+                throw std::bad_alloc();
+            }
+            stats_.on_allocation(new_capacity * sizeof(T));
+            stats_.on_growth(capacity_, new_capacity, block == data_ ? 0 : size_ * sizeof(T));
+            data_ = static_cast<T*>(block);
+        } else {
+            T* new_data = allocate(new_capacity);
+            try {
+                relocate_into(new_data);
+            } catch (...) {
+                deallocate(new_data, new_capacity);
+                throw;
+            }
+            stats_.on_growth(capacity_, new_capacity, size_ * sizeof(T));
+            data_ = new_data;
         }
+        capacity_ = new_capacity;
+    }
+
+    // reallocate() for a new capacity past the page-mapping threshold. A
+    // mapping is remapped; a malloc block is copied into a new mapping once,
+    // on the growth that crosses the threshold. Constrained so that explicit
+    // instantiations for other element types do not instantiate the memcpy.
+    void reallocate_page_mapped(std::size_t new_capacity)
+        requires k_grow_with_page_mapping
+    {
+        const std::size_t new_bytes = new_capacity * sizeof(T);
+        if (is_page_mapped(capacity_)) {
+            data_ = static_cast<T*>(detail::remap_pages(data_, capacity_ * sizeof(T), new_bytes));
+            stats_.on_growth(capacity_, new_capacity, 0);
+        } else {
+            T* new_data = static_cast<T*>(detail::map_pages(new_bytes));
+            if (size_ != 0) {
+                std::memcpy(new_data, data_, size_ * sizeof(T));
+            }
+            stats_.on_growth(capacity_, new_capacity, size_ * sizeof(T));
+            deallocate(data_, capacity_);
+            data_ = new_data;
+        }
+        stats_.on_allocation(new_bytes);
+        capacity_ = new_capacity;
+    }
+
+    // Moves (or, when moving could throw, copies) the elements into
+    // new_data and releases the old block. On exception the current elements
+    // are untouched and new_data holds no objects; the caller frees it.
+    void relocate_into(T* new_data) {
+        constexpr bool move = std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>;
+        construct_from<move>(new_data, data_, size_);
+
+        destroy_range(data_, data_ + size_);
+        deallocate(data_, capacity_);
+    }
 
-        const std::size_t new_capacity = capacity_ == 0 ? 4 : capacity_ * 2;
-        reserve(new_capacity);
+    [[nodiscard]] std::size_t grown_capacity() const noexcept {
+        return capacity_ == 0 ? 4 : capacity_ * 2;
     }
 
-    std::unique_ptr<T[]> data_{};
+    // Slow path of emplace_back. args may refer to an element of this array,
+    // so the new element is constructed before the old block is released.
+    template <typename... Args>
+    T& grow_and_emplace_back(Args&&... args) {
+        const std::size_t new_capacity = grown_capacity();
+
+        if constexpr (k_relocate_with_realloc) {
+            T value(std::forward<Args>(args)...);
+            reallocate(new_capacity);
+            T* element = data_ + size_;
+            AllocTraits::construct(alloc_, element, value);
+            ++size_;
+            return *element;
+        } else {
+            T* new_data = allocate(new_capacity);
+            T* element = new_data + size_;
+            try {
+                AllocTraits::construct(alloc_, element, std::forward<Args>(args)...);
+            } catch (...) {
+                deallocate(new_data, new_capacity);
+                throw;
+            }
+
+            try {
+                relocate_into(new_data);
+            } catch (...) {
+                AllocTraits::destroy(alloc_, element);
+                deallocate(new_data, new_capacity);
+                throw;
+            }
+
+            stats_.on_growth(capacity_, new_capacity, size_ * sizeof(T));
+            data_ = new_data;
+            capacity_ = new_capacity;
+            ++size_;
+            return *element;
+        }
+    }
+
+    [[no_unique_address]] Allocator alloc_{};
+    T* data_{nullptr};
     std::size_t size_{0};
     std::size_t capacity_{0};
+    [[no_unique_address]] Stats stats_{};
 };
 
-template <typename T>
-void swap(ResizingArray<T>& left, ResizingArray<T>& right) noexcept {
+template <typename T, typename Allocator, typename Stats>
+void swap(ResizingArray<T, Allocator, Stats>& left, ResizingArray<T, Allocator, Stats>& right) noexcept {
     left.swap(right);
 }
 
+namespace pmr {
+
+template <typename T>
+using ResizingArray = exemplar::ResizingArray<T, std::pmr::polymorphic_allocator<T>>;
+
+} // namespace pmr
+
 } // namespace exemplar
@@ -0,0 +1,8 @@
+#include "RingQueue.h"
+
+#include <memory_resource>
+#include <string>
+
+template class exemplar::RingQueue<int>;
+template class exemplar::RingQueue<std::string>;
+template class exemplar::RingQueue<std::pmr::string, std::pmr::polymorphic_allocator<std::pmr::string>>;
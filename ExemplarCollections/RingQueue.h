@@ -0,0 +1,353 @@
+#pragma once
+
+#include "AllocatorSupport.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace exemplar {
+
+// A FIFO queue in one contiguous circular buffer, with Queue's interface.
+//
+// Queue allocates a node per enqueue and frees it per dequeue; here the
+// elements sit side by side in a power-of-two buffer and head and tail just
+// wrap around it, so a steady stream of enqueues and dequeues allocates
+// nothing and walks memory sequentially. The power-of-two capacity turns
+// the wrap into a mask instead of a division.
+//
+// A full buffer grows by doubling: the elements are moved into the new
+// buffer in order (relinearized), with the head at slot 0.
+//
+// enqueue_range and dequeue_into move whole runs at a time: the live
+// region is at most two contiguous spans, so a bulk operation is at most
+// two straight loops with no per-element wrap check.
+template <typename T, typename Allocator = std::allocator<T>>
+class RingQueue {
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+
+    RingQueue() = default;
+
+    explicit RingQueue(const Allocator& alloc) noexcept : alloc_(alloc) {}
+
+    RingQueue(const RingQueue& other)
+        : RingQueue(other, AllocTraits::select_on_container_copy_construction(other.alloc_)) {}
+
+    RingQueue(const RingQueue& other, const Allocator& alloc) : alloc_(alloc) { append_from<false>(other); }
+
+    RingQueue& operator=(const RingQueue& other) {
+        if (this == &other) {
+            return *this;
+        }
+
+        RingQueue copy(other, detail::propagate_on_copy_assignment_v<Allocator> ? other.alloc_ : alloc_);
+        if constexpr (detail::propagate_on_copy_assignment_v<Allocator>) {
+            std::swap(alloc_, copy.alloc_);
+        }
+        swap_storage(copy);
+        return *this;
+    }
+
+    RingQueue(RingQueue&& other) noexcept : alloc_(std::move(other.alloc_)) { swap_storage(other); }
+
+    // Moves element by element when alloc cannot free other's buffer.
+    RingQueue(RingQueue&& other, const Allocator& alloc) : alloc_(alloc) {
+        if (alloc_ == other.alloc_) {
+            swap_storage(other);
+            return;
+        }
+        append_from<true>(other);
+    }
+
+    RingQueue& operator=(RingQueue&& other) noexcept(detail::nothrow_move_assignable_v<Allocator>) {
+        if (this == &other) {
+            return *this;
+        }
+
+        if constexpr (detail::propagate_on_move_assignment_v<Allocator>) {
+            release_storage();
+            alloc_ = std::move(other.alloc_);
+            swap_storage(other);
+        } else if (alloc_ == other.alloc_) {
+            release_storage();
+            swap_storage(other);
+        } else {
+            RingQueue moved(std::move(other), alloc_);
+            release_storage();
+            swap_storage(moved);
+        }
+        return *this;
+    }
+
+    ~RingQueue() { release_storage(); }
+
+    [[nodiscard]] allocator_type get_allocator() const noexcept { return alloc_; }
+
+    [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+    [[nodiscard]] std::size_t capacity() const noexcept { return capacity_; }
+
+    [[nodiscard]] static constexpr std::size_t max_size() noexcept {
+        return std::bit_floor(static_cast<std::size_t>(PTRDIFF_MAX) / sizeof(T));
+    }
+
+    void enqueue(const T& value) { emplace(value); }
+    void enqueue(T&& value) { emplace(std::move(value)); }
+
+    template <typename... Args>
+    T& emplace(Args&&... args) {
+        if (size_ == capacity_) {
+            // args may refer to an element about to be moved by the growth.
+            T value(std::forward<Args>(args)...);
+            grow(size_ + 1);
+            return construct_back(std::move(value));
+        }
+        return construct_back(std::forward<Args>(args)...);
+    }
+
+    // Enqueues every element of range in order. A sized range grows the
+    // buffer at most once and is copied in at most two contiguous runs.
+    template <std::ranges::input_range R>
+    void enqueue_range(R&& range) {
+        if constexpr (std::ranges::sized_range<R> && std::ranges::forward_range<R>) {
+            const auto count = static_cast<std::size_t>(std::ranges::size(range));
+            if (count > capacity_ - size_) {
+                grow(size_ + count);
+            }
+
+            auto source = std::ranges::begin(range);
+            const std::size_t tail = index(head_ + size_);
+            const std::size_t first_run = std::min(count, capacity_ - tail);
+            source = copy_run(source, buffer_ + tail, first_run);
+            copy_run(source, buffer_, count - first_run);
+        } else {
+            for (auto&& element : range) {
+                emplace(std::forward<decltype(element)>(element));
+            }
+        }
+    }
+
+    void dequeue() {
+        if (empty()) {
+            throw std::runtime_error("RingQueue::dequeue on empty queue");
+        }
+        AllocTraits::destroy(alloc_, buffer_ + head_);
+        head_ = index(head_ + 1);
+        --size_;
+    }
+
+    // Moves up to max_count elements from the front to out, in order, and
+    // dequeues them. Returns how many were moved.
+    template <std::output_iterator<T&&> Out>
+    std::size_t dequeue_into(Out out, std::size_t max_count) {
+        const std::size_t count = std::min(max_count, size_);
+        const std::size_t first_run = std::min(count, capacity_ - head_);
+        out = drain_run(first_run, std::move(out));
+        drain_run(count - first_run, std::move(out));
+        return count;
+    }
+
+    T& front() {
+        if (empty()) {
+            throw std::runtime_error("RingQueue::front on empty queue");
+        }
+        return buffer_[head_];
+    }
+
+    const T& front() const {
+        if (empty()) {
+            throw std::runtime_error("RingQueue::front on empty queue");
+        }
+        return buffer_[head_];
+    }
+
+    T& back() {
+        if (empty()) {
+            throw std::runtime_error("RingQueue::back on empty queue");
+        }
+        return buffer_[index(head_ + size_ - 1)];
+    }
+
+    const T& back() const {
+        if (empty()) {
+            throw std::runtime_error("RingQueue::back on empty queue");
+        }
+        return buffer_[index(head_ + size_ - 1)];
+    }
+
+    // Keeps the buffer for reuse.
+    void clear() noexcept {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (std::size_t i = 0; i < size_; ++i) {
+                AllocTraits::destroy(alloc_, buffer_ + index(head_ + i));
+            }
+        }
+        head_ = 0;
+        size_ = 0;
+    }
+
+    // Rounds new_capacity up to a power of two.
+    void reserve(std::size_t new_capacity) {
+        if (new_capacity > capacity_) {
+            grow(new_capacity);
+        }
+    }
+
+    // As with the std containers, swapping queues whose allocators differ
+    // and do not propagate on swap is undefined.
+    void swap(RingQueue& other) noexcept {
+        if constexpr (detail::propagate_on_swap_v<Allocator>) {
+            std::swap(alloc_, other.alloc_);
+        }
+        swap_storage(other);
+    }
+
+private:
+    using AllocTraits = std::allocator_traits<Allocator>;
+
+    static_assert(std::is_same_v<typename AllocTraits::pointer, T*>, "fancy allocator pointers are not supported");
+
+    static constexpr std::size_t k_min_capacity = 16;
+
+    // Slot of logical position position; capacity_ is a power of two.
+    [[nodiscard]] std::size_t index(std::size_t position) const noexcept { return position & (capacity_ - 1); }
+
+    template <typename... Args>
+    T& construct_back(Args&&... args) {
+        T* slot = buffer_ + index(head_ + size_);
+        AllocTraits::construct(alloc_, slot, std::forward<Args>(args)...);
+        ++size_;
+        return *slot;
+    }
+
+    // Constructs count elements from source at destination, one run of the
+    // ring. size_ counts each one as it lands, so a throw leaves a valid
+    // queue holding the elements enqueued so far.
+    template <typename It>
+    It copy_run(It source, T* destination, std::size_t count) {
+        for (std::size_t i = 0; i < count; ++i, ++source) {
+            AllocTraits::construct(alloc_, destination + i, *source);
+            ++size_;
+        }
+        return source;
+    }
+
+    // Moves count elements from the front to out, one run of the ring, and
+    // dequeues them. If out throws, the elements already moved (and
+    // destroyed) are still dequeued, so none is destroyed twice.
+    template <typename Out>
+    Out drain_run(std::size_t count, Out out) {
+        T* first = buffer_ + head_;
+        std::size_t moved = 0;
+        try {
+            for (; moved < count; ++moved, ++out) {
+                *out = std::move(first[moved]);
+                AllocTraits::destroy(alloc_, first + moved);
+            }
+        } catch (...) {
+            head_ = index(head_ + moved);
+            size_ -= moved;
+            throw;
+        }
+        head_ = index(head_ + count);
+        size_ -= count;
+        return out;
+    }
+
+    // Moves the elements, front first, into a buffer of at least
+    // min_capacity (a power of two, at least double the current one).
+    // Strong guarantee when T's move constructor does not throw; otherwise
+    // the elements are copied.
+    void grow(std::size_t min_capacity) {
+        if (min_capacity > max_size()) {
+            throw std::length_error("RingQueue capacity exceeds max_size");
+        }
+
+        const std::size_t new_capacity = std::max({std::bit_ceil(min_capacity), capacity_ * 2, k_min_capacity});
+        T* fresh = AllocTraits::allocate(alloc_, new_capacity);
+        std::size_t built = 0;
+        try {
+            for (; built < size_; ++built) {
+                AllocTraits::construct(alloc_, fresh + built, std::move_if_noexcept(buffer_[index(head_ + built)]));
+            }
+        } catch (...) {
+            for (std::size_t i = 0; i < built; ++i) {
+                AllocTraits::destroy(alloc_, fresh + i);
+            }
+            AllocTraits::deallocate(alloc_, fresh, new_capacity);
+            throw;
+        }
+
+        const std::size_t count = size_;
+        release_storage();
+        buffer_ = fresh;
+        capacity_ = new_capacity;
+        size_ = count;
+    }
+
+    // Destroys the elements and frees the buffer.
+    void release_storage() noexcept {
+        clear();
+        if (buffer_ != nullptr) {
+            AllocTraits::deallocate(alloc_, buffer_, capacity_);
+        }
+        buffer_ = nullptr;
+        capacity_ = 0;
+    }
+
+    void swap_storage(RingQueue& other) noexcept {
+        std::swap(buffer_, other.buffer_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(head_, other.head_);
+        std::swap(size_, other.size_);
+    }
+
+    // Appends other's elements (moved when Move) to this empty queue.
+    template <bool Move>
+    void append_from(std::conditional_t<Move, RingQueue&, const RingQueue&> other) {
+        try {
+            reserve(other.size_);
+            for (std::size_t i = 0; i < other.size_; ++i) {
+                auto& element = other.buffer_[other.index(other.head_ + i)];
+                if constexpr (Move) {
+                    construct_back(std::move(element));
+                } else {
+                    construct_back(element);
+                }
+            }
+        } catch (...) {
+            release_storage();
+            throw;
+        }
+    }
+
+    [[no_unique_address]] Allocator alloc_{};
+    T* buffer_{nullptr};
+    std::size_t capacity_{0};
+    std::size_t head_{0};
+    std::size_t size_{0};
+};
+
+template <typename T, typename Allocator>
+void swap(RingQueue<T, Allocator>& left, RingQueue<T, Allocator>& right) noexcept {
+    left.swap(right);
+}
+
+namespace pmr {
+
+template <typename T>
+using RingQueue = exemplar::RingQueue<T, std::pmr::polymorphic_allocator<T>>;
+
+} // namespace pmr
+
+} // namespace exemplar
@@ -0,0 +1,8 @@
+#include "SegmentedArray.h"
+
+#include <memory_resource>
+#include <string>
+
+template class exemplar::SegmentedArray<int>;
+template class exemplar::SegmentedArray<std::string>;
+template class exemplar::SegmentedArray<std::pmr::string, std::pmr::polymorphic_allocator<std::pmr::string>>;
@@ -0,0 +1,398 @@
+#pragma once
+
+#include "AllocatorSupport.h"
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace exemplar {
+
+// A growable array whose elements never move.
+//
+// Storage is a fixed table of blocks whose sizes double: block 0 holds
+// k_first_block_size elements, block k holds k_first_block_size << k.
+// Growth allocates the next block and leaves the existing ones alone, so
+// pointers and references to elements stay valid until the element is
+// popped (or the array cleared or destroyed), and growth costs one
+// allocation instead of moving every element.
+//
+// Index i lives in block bit_width(i + k_first_block_size) - 1 -
+// k_first_block_shift; finding it is a count-leading-zeros, a shift and a
+// subtraction, with no loop.
+//
+// Trade-offs against ResizingArray: the elements are not contiguous (no
+// data()), operator[] does the block arithmetic plus one extra load, and
+// the block table makes sizeof a few hundred bytes.
+template <typename T, typename Allocator = std::allocator<T>>
+class SegmentedArray {
+    template <bool Const>
+    class Iterator;
+
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    static constexpr std::size_t k_first_block_shift = 4;
+    static constexpr std::size_t k_first_block_size = std::size_t{1} << k_first_block_shift;
+
+    SegmentedArray() = default;
+
+    explicit SegmentedArray(const Allocator& alloc) noexcept : alloc_(alloc) {}
+
+    SegmentedArray(const SegmentedArray& other)
+        : SegmentedArray(other, AllocTraits::select_on_container_copy_construction(other.alloc_)) {}
+
+    SegmentedArray(const SegmentedArray& other, const Allocator& alloc) : alloc_(alloc) {
+        try {
+            append_from<false>(other);
+        } catch (...) {
+            release_storage();
+            throw;
+        }
+    }
+
+    SegmentedArray& operator=(const SegmentedArray& other) {
+        if (this == &other) {
+            return *this;
+        }
+
+        SegmentedArray copy(other, detail::propagate_on_copy_assignment_v<Allocator> ? other.alloc_ : alloc_);
+        if constexpr (detail::propagate_on_copy_assignment_v<Allocator>) {
+            std::swap(alloc_, copy.alloc_);
+        }
+        swap_storage(copy);
+        return *this;
+    }
+
+    SegmentedArray(SegmentedArray&& other) noexcept : alloc_(std::move(other.alloc_)) { swap_storage(other); }
+
+    // Moves element by element when alloc cannot free other's blocks.
+    SegmentedArray(SegmentedArray&& other, const Allocator& alloc) : alloc_(alloc) {
+        if (alloc_ == other.alloc_) {
+            swap_storage(other);
+            return;
+        }
+
+        try {
+            append_from<true>(other);
+        } catch (...) {
+            release_storage();
+            throw;
+        }
+    }
+
+    SegmentedArray& operator=(SegmentedArray&& other) noexcept(detail::nothrow_move_assignable_v<Allocator>) {
+        if (this == &other) {
+            return *this;
+        }
+
+        if constexpr (detail::propagate_on_move_assignment_v<Allocator>) {
+            release_storage();
+            alloc_ = std::move(other.alloc_);
+            swap_storage(other);
+        } else if (alloc_ == other.alloc_) {
+            release_storage();
+            swap_storage(other);
+        } else {
+            SegmentedArray moved(std::move(other), alloc_);
+            release_storage();
+            swap_storage(moved);
+        }
+        return *this;
+    }
+
+    ~SegmentedArray() { release_storage(); }
+
+    [[nodiscard]] allocator_type get_allocator() const noexcept { return alloc_; }
+
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+    [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+
+    // Elements the allocated blocks can hold.
+    [[nodiscard]] std::size_t capacity() const noexcept { return capacity_before(block_count_); }
+
+    [[nodiscard]] static constexpr std::size_t max_size() noexcept { return PTRDIFF_MAX / sizeof(T); }
+
+    T& operator[](std::size_t index) noexcept { return *slot(index); }
+    const T& operator[](std::size_t index) const noexcept { return *slot(index); }
+
+    T& at(std::size_t index) {
+        if (index >= size_) {
+            throw std::out_of_range("SegmentedArray::at index out of range");
+        }
+        return *slot(index);
+    }
+
+    const T& at(std::size_t index) const {
+        if (index >= size_) {
+            throw std::out_of_range("SegmentedArray::at index out of range");
+        }
+        return *slot(index);
+    }
+
+    T& front() {
+        if (empty()) {
+            throw std::runtime_error("SegmentedArray::front on empty container");
+        }
+        return *blocks_[0];
+    }
+
+    const T& front() const {
+        if (empty()) {
+            throw std::runtime_error("SegmentedArray::front on empty container");
+        }
+        return *blocks_[0];
+    }
+
+    T& back() {
+        if (empty()) {
+            throw std::runtime_error("SegmentedArray::back on empty container");
+        }
+        return *slot(size_ - 1);
+    }
+
+    const T& back() const {
+        if (empty()) {
+            throw std::runtime_error("SegmentedArray::back on empty container");
+        }
+        return *slot(size_ - 1);
+    }
+
+    iterator begin() noexcept { return iterator(blocks_, 0); }
+    iterator end() noexcept { return iterator(blocks_, size_); }
+    const_iterator begin() const noexcept { return const_iterator(blocks_, 0); }
+    const_iterator end() const noexcept { return const_iterator(blocks_, size_); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    void push_back(const T& value) { emplace_back(value); }
+
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+
+    // No element moves, so args may safely refer to an element of this array.
+    template <typename... Args>
+    T& emplace_back(Args&&... args) {
+        if (size_ == capacity()) {
+            add_block();
+        }
+
+        T* element = slot(size_);
+        AllocTraits::construct(alloc_, element, std::forward<Args>(args)...);
+        ++size_;
+        return *element;
+    }
+
+    // Keeps the blocks for reuse; see shrink_to_fit.
+    void pop_back() {
+        if (empty()) {
+            throw std::runtime_error("SegmentedArray::pop_back on empty container");
+        }
+        AllocTraits::destroy(alloc_, slot(--size_));
+    }
+
+    void clear() noexcept {
+        destroy_elements();
+        size_ = 0;
+    }
+
+    void reserve(std::size_t new_capacity) {
+        if (new_capacity > max_size()) {
+            throw std::length_error("SegmentedArray capacity exceeds max_size");
+        }
+
+        while (capacity() < new_capacity) {
+            add_block();
+        }
+    }
+
+    // Frees the blocks past the one holding the last element.
+    void shrink_to_fit() noexcept {
+        const std::size_t needed = size_ == 0 ? 0 : locate(size_ - 1).block + 1;
+        while (block_count_ > needed) {
+            --block_count_;
+            AllocTraits::deallocate(alloc_, blocks_[block_count_], block_size(block_count_));
+            blocks_[block_count_] = nullptr;
+        }
+    }
+
+    // As with the std containers, swapping arrays whose allocators differ
+    // and do not propagate on swap is undefined.
+    void swap(SegmentedArray& other) noexcept {
+        if constexpr (detail::propagate_on_swap_v<Allocator>) {
+            std::swap(alloc_, other.alloc_);
+        }
+        swap_storage(other);
+    }
+
+private:
+    using AllocTraits = std::allocator_traits<Allocator>;
+
+    static_assert(std::is_same_v<typename AllocTraits::pointer, T*>, "fancy allocator pointers are not supported");
+
+    // Enough blocks to reach max_size(). The table has one spare null entry
+    // so that an iterator stepping off the last full block has somewhere
+    // to land.
+    static constexpr std::size_t k_max_blocks = std::bit_width(max_size() / k_first_block_size);
+
+    struct Location {
+        std::size_t block;
+        std::size_t offset;
+    };
+
+    [[nodiscard]] static constexpr std::size_t block_size(std::size_t block) noexcept {
+        return k_first_block_size << block;
+    }
+
+    // Elements held by blocks [0, block).
+    [[nodiscard]] static constexpr std::size_t capacity_before(std::size_t block) noexcept {
+        return block_size(block) - k_first_block_size;
+    }
+
+    // Offsetting the index by the first block's size makes every block
+    // start at a power of two: block k covers [2^(k+shift), 2^(k+shift+1)).
+    [[nodiscard]] static constexpr Location locate(std::size_t index) noexcept {
+        const std::size_t biased = index + k_first_block_size;
+        const std::size_t block = static_cast<std::size_t>(std::bit_width(biased)) - 1 - k_first_block_shift;
+        return {block, biased - block_size(block)};
+    }
+
+    [[nodiscard]] T* slot(std::size_t index) const noexcept {
+        const Location location = locate(index);
+        return blocks_[location.block] + location.offset;
+    }
+
+    void add_block() {
+        if (block_count_ == k_max_blocks) {
+            throw std::length_error("SegmentedArray capacity exceeds max_size");
+        }
+        blocks_[block_count_] = AllocTraits::allocate(alloc_, block_size(block_count_));
+        ++block_count_;
+    }
+
+    void destroy_elements() noexcept {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (T& element : *this) {
+                AllocTraits::destroy(alloc_, std::addressof(element));
+            }
+        }
+    }
+
+    // Destroys the elements and frees every block.
+    void release_storage() noexcept {
+        clear();
+        shrink_to_fit();
+    }
+
+    void swap_storage(SegmentedArray& other) noexcept {
+        std::swap(blocks_, other.blocks_);
+        std::swap(size_, other.size_);
+        std::swap(block_count_, other.block_count_);
+    }
+
+    // Appends other's elements (moved when Move) to this empty array.
+    template <bool Move>
+    void append_from(std::conditional_t<Move, SegmentedArray&, const SegmentedArray&> other) {
+        reserve(other.size_);
+        for (auto& element : other) {
+            if constexpr (Move) {
+                AllocTraits::construct(alloc_, slot(size_), std::move(element));
+            } else {
+                AllocTraits::construct(alloc_, slot(size_), element);
+            }
+            ++size_;
+        }
+    }
+
+    [[no_unique_address]] Allocator alloc_{};
+    T* blocks_[k_max_blocks + 1]{};
+    std::size_t size_{0};
+    std::size_t block_count_{0};
+};
+
+// Forward iterator that walks a block with a plain pointer and only
+// consults the block table when it crosses into the next block.
+template <typename T, typename Allocator>
+template <bool Const>
+class SegmentedArray<T, Allocator>::Iterator {
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::conditional_t<Const, const T*, T*>;
+    using reference = std::conditional_t<Const, const T&, T&>;
+
+    Iterator() = default;
+
+    // const_iterator from iterator.
+    Iterator(const Iterator<false>& other) noexcept
+        requires Const
+        : blocks_(other.blocks_), block_(other.block_), current_(other.current_), block_end_(other.block_end_) {}
+
+    reference operator*() const noexcept { return *current_; }
+    pointer operator->() const noexcept { return current_; }
+
+    Iterator& operator++() noexcept {
+        if (++current_ == block_end_) {
+            enter_block(block_ + 1, 0);
+        }
+        return *this;
+    }
+
+    Iterator operator++(int) noexcept {
+        Iterator previous = *this;
+        ++*this;
+        return previous;
+    }
+
+    // Positions are compared by address. end() of an array that exactly
+    // fills its last block points at the start of the next (possibly
+    // unallocated, so null) block, which is also where ++ lands.
+    friend bool operator==(const Iterator& left, const Iterator& right) noexcept {
+        return left.current_ == right.current_;
+    }
+
+private:
+    friend class SegmentedArray;
+    friend class Iterator<!Const>;
+
+    Iterator(T* const* blocks, std::size_t index) noexcept : blocks_(blocks) {
+        const Location location = locate(index);
+        enter_block(location.block, location.offset);
+    }
+
+    // An unallocated block leaves both pointers null: only end() is there.
+    void enter_block(std::size_t block, std::size_t offset) noexcept {
+        block_ = block;
+        T* first = blocks_[block];
+        current_ = first == nullptr ? nullptr : first + offset;
+        block_end_ = first == nullptr ? nullptr : first + block_size(block);
+    }
+
+    T* const* blocks_{nullptr};
+    std::size_t block_{0};
+    pointer current_{nullptr};
+    pointer block_end_{nullptr};
+};
+
+template <typename T, typename Allocator>
+void swap(SegmentedArray<T, Allocator>& left, SegmentedArray<T, Allocator>& right) noexcept {
+    left.swap(right);
+}
+
+namespace pmr {
+
+template <typename T>
+using SegmentedArray = exemplar::SegmentedArray<T, std::pmr::polymorphic_allocator<T>>;
+
+} // namespace pmr
+
+} // namespace exemplar
@@ -1,6 +1,8 @@
 #include "SinglyLinkedList.h"
 
+#include <memory_resource>
 #include <string>
 
 template class exemplar::SinglyLinkedList<int>;
 template class exemplar::SinglyLinkedList<std::string>;
+template class exemplar::SinglyLinkedList<std::pmr::string, std::pmr::polymorphic_allocator<std::pmr::string>>;
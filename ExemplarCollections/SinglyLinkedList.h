@@ -1,7 +1,10 @@
 #pragma once
 
+#include "AllocatorSupport.h"
+
 #include <cstddef>
 #include <memory>
+#include <memory_resource>
 #include <optional>
 #include <stdexcept>
 #include <utility>
@@ -9,17 +12,30 @@
 namespace exemplar {
 
 // A minimal singly linked list.
-// Node ownership uses std::unique_ptr so destruction is automatic.
-template <typename T>
+// Nodes are allocated from Allocator (rebound to the node type) and owned
+// through raw pointers; clear() frees them one at a time.
+// With a std::pmr allocator the elements are constructed with it too.
+template <typename T, typename Allocator = std::allocator<T>>
 class SinglyLinkedList {
 public:
+    using allocator_type = Allocator;
+
     SinglyLinkedList() = default;
 
-    SinglyLinkedList(const SinglyLinkedList& other) {
-        const Node* cursor = other.head_.get();
-        while (cursor != nullptr) {
-            push_back(cursor->value);
-            cursor = cursor->next.get();
+    explicit SinglyLinkedList(const Allocator& alloc) noexcept : node_alloc_(alloc) {}
+
+    SinglyLinkedList(const SinglyLinkedList& other)
+        : SinglyLinkedList(other,
+                           std::allocator_traits<Allocator>::select_on_container_copy_construction(other.get_allocator())) {}
+
+    SinglyLinkedList(const SinglyLinkedList& other, const Allocator& alloc) : node_alloc_(alloc) {
+        try {
+            for (const Node* cursor = other.head_; cursor != nullptr; cursor = cursor->next) {
+                push_back(cursor->value);
+            }
+        } catch (...) {
+            clear();
+            throw;
         }
     }
 
@@ -28,56 +44,77 @@ public:
             return *this;
         }
 
-        SinglyLinkedList copy(other);
-        swap(copy);
+        SinglyLinkedList copy(other, detail::propagate_on_copy_assignment_v<Allocator> ? other.get_allocator()
+                                                                                        : get_allocator());
+        if constexpr (detail::propagate_on_copy_assignment_v<Allocator>) {
+            std::swap(node_alloc_, copy.node_alloc_);
+        }
+        swap_nodes(copy);
         return *this;
     }
 
-    SinglyLinkedList(SinglyLinkedList&&) noexcept = default;
-    SinglyLinkedList& operator=(SinglyLinkedList&&) noexcept = default;
-    ~SinglyLinkedList() = default;
-
-    [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
-    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+    SinglyLinkedList(SinglyLinkedList&& other) noexcept : node_alloc_(std::move(other.node_alloc_)) {
+        swap_nodes(other);
+    }
 
-    void push_front(const T& value) {
-        auto new_head = std::make_unique<Node>(value);
-        if (empty()) {
-            tail_ = new_head.get();
+    // Moves element by element when alloc cannot free other's nodes.
+    SinglyLinkedList(SinglyLinkedList&& other, const Allocator& alloc) : node_alloc_(alloc) {
+        if (node_alloc_ == other.node_alloc_) {
+            swap_nodes(other);
+            return;
         }
 
-        new_head->next = std::move(head_);
-        head_ = std::move(new_head);
-        ++size_;
+        try {
+            for (Node* cursor = other.head_; cursor != nullptr; cursor = cursor->next) {
+                push_back(std::move(cursor->value));
+            }
+        } catch (...) {
+            clear();
+            throw;
+        }
     }
 
-    void push_front(T&& value) {
-        auto new_head = std::make_unique<Node>(std::move(value));
-        if (empty()) {
-            tail_ = new_head.get();
+    SinglyLinkedList& operator=(SinglyLinkedList&& other) noexcept(detail::nothrow_move_assignable_v<Allocator>) {
+        if (this == &other) {
+            return *this;
         }
 
-        new_head->next = std::move(head_);
-        head_ = std::move(new_head);
-        ++size_;
+        if constexpr (detail::propagate_on_move_assignment_v<Allocator>) {
+            clear();
+            node_alloc_ = std::move(other.node_alloc_);
+            swap_nodes(other);
+        } else if (node_alloc_ == other.node_alloc_) {
+            clear();
+            swap_nodes(other);
+        } else {
+            SinglyLinkedList moved(std::move(other), get_allocator());
+            clear();
+            swap_nodes(moved);
+        }
+        return *this;
     }
 
-    void push_back(const T& value) {
-        auto node = std::make_unique<Node>(value);
-        append_node(std::move(node));
-    }
+    ~SinglyLinkedList() { clear(); }
 
-    void push_back(T&& value) {
-        auto node = std::make_unique<Node>(std::move(value));
-        append_node(std::move(node));
-    }
+    [[nodiscard]] allocator_type get_allocator() const noexcept { return allocator_type(node_alloc_); }
+
+    [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+
+    void push_front(const T& value) { link_front(detail::new_node(node_alloc_, get_allocator(), value)); }
+    void push_front(T&& value) { link_front(detail::new_node(node_alloc_, get_allocator(), std::move(value))); }
+
+    void push_back(const T& value) { link_back(detail::new_node(node_alloc_, get_allocator(), value)); }
+    void push_back(T&& value) { link_back(detail::new_node(node_alloc_, get_allocator(), std::move(value))); }
 
     void pop_front() {
         if (empty()) {
             throw std::runtime_error("SinglyLinkedList::pop_front on empty list");
         }
 
-        head_ = std::move(head_->next);
+        Node* old_head = head_;
+        head_ = head_->next;
+        detail::delete_node(node_alloc_, old_head);
         --size_;
 
         if (size_ == 0) {
@@ -114,68 +151,104 @@ public:
     }
 
     [[nodiscard]] bool contains(const T& target) const {
-        const Node* cursor = head_.get();
+        const Node* cursor = head_;
         while (cursor != nullptr) {
             if (cursor->value == target) {
                 return true;
             }
-            cursor = cursor->next.get();
+            cursor = cursor->next;
         }
         return false;
     }
 
     std::optional<T> find_first(const T& target) const {
-        const Node* cursor = head_.get();
+        const Node* cursor = head_;
         while (cursor != nullptr) {
             if (cursor->value == target) {
                 return cursor->value;
             }
-            cursor = cursor->next.get();
+            cursor = cursor->next;
         }
         return std::nullopt;
     }
 
     void clear() noexcept {
-        head_.reset();
+        Node* cursor = head_;
+        while (cursor != nullptr) {
+            Node* next = cursor->next;
+            detail::delete_node(node_alloc_, cursor);
+            cursor = next;
+        }
+
+        head_ = nullptr;
         tail_ = nullptr;
         size_ = 0;
     }
 
+    // As with the std containers, swapping lists whose allocators differ
+    // and do not propagate on swap is undefined.
     void swap(SinglyLinkedList& other) noexcept {
-        std::swap(head_, other.head_);
-        std::swap(tail_, other.tail_);
-        std::swap(size_, other.size_);
+        if constexpr (detail::propagate_on_swap_v<Allocator>) {
+            std::swap(node_alloc_, other.node_alloc_);
+        }
+        swap_nodes(other);
     }
 
 private:
     struct Node {
-        explicit Node(const T& v) : value(v) {}
-        explicit Node(T&& v) : value(std::move(v)) {}
+        template <typename... Args>
+        explicit Node(const Allocator& alloc, Args&&... args)
+            : value(std::make_obj_using_allocator<T>(alloc, std::forward<Args>(args)...)) {}
 
         T value;
-        std::unique_ptr<Node> next{};
+        Node* next{nullptr};
     };
 
-    void append_node(std::unique_ptr<Node> node) {
-        Node* raw = node.get();
+    using NodeAllocator = detail::rebind_alloc_t<Allocator, Node>;
+
+    void link_front(Node* node) {
         if (empty()) {
-            head_ = std::move(node);
-            tail_ = raw;
+            tail_ = node;
+        }
+
+        node->next = head_;
+        head_ = node;
+        ++size_;
+    }
+
+    void link_back(Node* node) {
+        if (empty()) {
+            head_ = node;
         } else {
-            tail_->next = std::move(node);
-            tail_ = raw;
+            tail_->next = node;
         }
+
+        tail_ = node;
         ++size_;
     }
 
-    std::unique_ptr<Node> head_{};
+    void swap_nodes(SinglyLinkedList& other) noexcept {
+        std::swap(head_, other.head_);
+        std::swap(tail_, other.tail_);
+        std::swap(size_, other.size_);
+    }
+
+    [[no_unique_address]] NodeAllocator node_alloc_{};
+    Node* head_{nullptr};
     Node* tail_{nullptr};
     std::size_t size_{0};
 };
 
-template <typename T>
-void swap(SinglyLinkedList<T>& left, SinglyLinkedList<T>& right) noexcept {
+template <typename T, typename Allocator>
+void swap(SinglyLinkedList<T, Allocator>& left, SinglyLinkedList<T, Allocator>& right) noexcept {
     left.swap(right);
 }
 
+namespace pmr {
+
+template <typename T>
+using SinglyLinkedList = exemplar::SinglyLinkedList<T, std::pmr::polymorphic_allocator<T>>;
+
+} // namespace pmr
+
 } // namespace exemplar
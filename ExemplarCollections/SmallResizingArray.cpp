@@ -0,0 +1,6 @@
+#include "SmallResizingArray.h"
+
+#include <string>
+
+template class exemplar::SmallResizingArray<int, 8>;
+template class exemplar::SmallResizingArray<std::string, 4>;
@@ -0,0 +1,300 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace exemplar {
+
+// ResizingArray with room for N elements inside the object itself
+// (small-buffer optimization). Up to N elements live inline and never touch
+// the allocator; the first push beyond N moves everything to the heap, and
+// from then on it grows like ResizingArray.
+//
+// Trade-offs: sizeof grows by N * sizeof(T), and moving an inline array
+// moves its elements one by one (O(N)) instead of stealing a pointer.
+template <typename T, std::size_t N>
+class SmallResizingArray {
+    static_assert(N > 0, "SmallResizingArray needs an inline capacity of at least one element");
+
+public:
+    SmallResizingArray() noexcept = default;
+
+    explicit SmallResizingArray(std::size_t initial_capacity) { reserve(initial_capacity); }
+
+    SmallResizingArray(const SmallResizingArray& other) {
+        reserve(other.size_);
+        try {
+            std::uninitialized_copy(other.data_, other.data_ + other.size_, data_);
+        } catch (...) {
+            release_heap();
+            throw;
+        }
+        size_ = other.size_;
+    }
+
+    SmallResizingArray& operator=(const SmallResizingArray& other) {
+        if (this == &other) {
+            return *this;
+        }
+
+        SmallResizingArray copy(other);
+        *this = std::move(copy);
+        return *this;
+    }
+
+    // Steals other's heap block, or moves its inline elements over.
+    // Either way other is left empty and inline.
+    SmallResizingArray(SmallResizingArray&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        take(other);
+    }
+
+    SmallResizingArray& operator=(SmallResizingArray&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if (this == &other) {
+            return *this;
+        }
+
+        clear();
+        release_heap();
+        take(other);
+        return *this;
+    }
+
+    ~SmallResizingArray() {
+        clear();
+        release_heap();
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+    [[nodiscard]] std::size_t capacity() const noexcept { return capacity_; }
+    [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+
+    // True while the elements are stored inside the object.
+    [[nodiscard]] bool is_inline() const noexcept { return data_ == inline_data(); }
+
+    [[nodiscard]] static constexpr std::size_t inline_capacity() noexcept { return N; }
+    [[nodiscard]] static constexpr std::size_t max_size() noexcept { return PTRDIFF_MAX / sizeof(T); }
+
+    T* data() noexcept { return data_; }
+    const T* data() const noexcept { return data_; }
+
+    T& operator[](std::size_t index) noexcept { return data_[index]; }
+    const T& operator[](std::size_t index) const noexcept { return data_[index]; }
+
+    T& at(std::size_t index) {
+        if (index >= size_) {
+            throw std::out_of_range("SmallResizingArray::at index out of range");
+        }
+        return data_[index];
+    }
+
+    const T& at(std::size_t index) const {
+        if (index >= size_) {
+            throw std::out_of_range("SmallResizingArray::at index out of range");
+        }
+        return data_[index];
+    }
+
+    T& front() {
+        if (empty()) {
+            throw std::runtime_error("SmallResizingArray::front on empty container");
+        }
+        return data_[0];
+    }
+
+    const T& front() const {
+        if (empty()) {
+            throw std::runtime_error("SmallResizingArray::front on empty container");
+        }
+        return data_[0];
+    }
+
+    T& back() {
+        if (empty()) {
+            throw std::runtime_error("SmallResizingArray::back on empty container");
+        }
+        return data_[size_ - 1];
+    }
+
+    const T& back() const {
+        if (empty()) {
+            throw std::runtime_error("SmallResizingArray::back on empty container");
+        }
+        return data_[size_ - 1];
+    }
+
+    void push_back(const T& value) { emplace_back(value); }
+
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+
+    template <typename... Args>
+    T& emplace_back(Args&&... args) {
+        if (size_ == capacity_) {
+            return grow_and_emplace_back(std::forward<Args>(args)...);
+        }
+
+        T* element = std::construct_at(data_ + size_, std::forward<Args>(args)...);
+        ++size_;
+        return *element;
+    }
+
+    void pop_back() {
+        if (empty()) {
+            throw std::runtime_error("SmallResizingArray::pop_back on empty container");
+        }
+        std::destroy_at(data_ + --size_);
+    }
+
+    // Keeps the current storage, heap or inline.
+    void clear() noexcept {
+        std::destroy(data_, data_ + size_);
+        size_ = 0;
+    }
+
+    void reserve(std::size_t new_capacity) {
+        if (new_capacity <= capacity_) {
+            return;
+        }
+
+        T* new_data = allocate(new_capacity);
+        try {
+            relocate_into(new_data);
+        } catch (...) {
+            deallocate(new_data, new_capacity);
+            throw;
+        }
+        adopt(new_data, new_capacity);
+    }
+
+    // Shrinks to new_size, or grows with value-initialized elements.
+    void resize(std::size_t new_size) {
+        if (new_size <= size_) {
+            std::destroy(data_ + new_size, data_ + size_);
+            size_ = new_size;
+            return;
+        }
+
+        reserve(new_size);
+        std::uninitialized_value_construct(data_ + size_, data_ + new_size);
+        size_ = new_size;
+    }
+
+    // Like resize, but new elements are left with indeterminate values;
+    // see ResizingArray::resize_uninitialized.
+    void resize_uninitialized(std::size_t new_size)
+        requires std::is_trivially_default_constructible_v<T> && std::is_trivially_destructible_v<T>
+    {
+        reserve(new_size);
+        if (new_size > size_) {
+            std::uninitialized_default_construct(data_ + size_, data_ + new_size);
+        }
+        size_ = new_size;
+    }
+
+    void swap(SmallResizingArray& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        SmallResizingArray moved(std::move(other));
+        other = std::move(*this);
+        *this = std::move(moved);
+    }
+
+private:
+    T* inline_data() noexcept { return reinterpret_cast<T*>(inline_storage_); }
+    const T* inline_data() const noexcept { return reinterpret_cast<const T*>(inline_storage_); }
+
+    [[nodiscard]] static T* allocate(std::size_t capacity) {
+        if (capacity > max_size()) {
+            throw std::length_error("SmallResizingArray capacity exceeds max_size");
+        }
+        return std::allocator<T>{}.allocate(capacity);
+    }
+
+    static void deallocate(T* data, std::size_t capacity) noexcept { std::allocator<T>{}.deallocate(data, capacity); }
+
+    // Frees the heap block, if any, and points back at the inline buffer.
+    // The caller has already destroyed the elements.
+    void release_heap() noexcept {
+        if (!is_inline()) {
+            deallocate(data_, capacity_);
+            data_ = inline_data();
+            capacity_ = N;
+        }
+    }
+
+    // Takes other's elements into this empty, inline array.
+    void take(SmallResizingArray& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if (other.is_inline()) {
+            std::uninitialized_move(other.data_, other.data_ + other.size_, data_);
+            size_ = other.size_;
+            other.clear();
+            return;
+        }
+
+        data_ = std::exchange(other.data_, other.inline_data());
+        size_ = std::exchange(other.size_, 0);
+        capacity_ = std::exchange(other.capacity_, N);
+    }
+
+    // Moves (or, when moving could throw, copies) the elements into
+    // new_data. On exception the current elements are untouched.
+    void relocate_into(T* new_data) {
+        if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
+            std::uninitialized_move(data_, data_ + size_, new_data);
+        } else {
+            std::uninitialized_copy(data_, data_ + size_, new_data);
+        }
+    }
+
+    // Destroys the old elements, frees a heap block and switches to new_data,
+    // which already holds the relocated elements.
+    void adopt(T* new_data, std::size_t new_capacity) noexcept {
+        std::destroy(data_, data_ + size_);
+        release_heap();
+        data_ = new_data;
+        capacity_ = new_capacity;
+    }
+
+    // Slow path of emplace_back. args may refer to an element of this array,
+    // so the new element is constructed before the old elements are moved.
+    template <typename... Args>
+    T& grow_and_emplace_back(Args&&... args) {
+        const std::size_t new_capacity = capacity_ * 2;
+        T* new_data = allocate(new_capacity);
+        T* element = nullptr;
+        try {
+            element = std::construct_at(new_data + size_, std::forward<Args>(args)...);
+        } catch (...) {
+            deallocate(new_data, new_capacity);
+            throw;
+        }
+
+        try {
+            relocate_into(new_data);
+        } catch (...) {
+            std::destroy_at(element);
+            deallocate(new_data, new_capacity);
+            throw;
+        }
+
+        adopt(new_data, new_capacity);
+        ++size_;
+        return *element;
+    }
+
+    T* data_{inline_data()};
+    std::size_t size_{0};
+    std::size_t capacity_{N};
+    alignas(T) std::byte inline_storage_[N * sizeof(T)];
+};
+
+template <typename T, std::size_t N>
+void swap(SmallResizingArray<T, N>& left, SmallResizingArray<T, N>& right) noexcept(
+    std::is_nothrow_move_constructible_v<T>) {
+    left.swap(right);
+}
+
+} // namespace exemplar
@@ -0,0 +1,6 @@
+#include "SpscQueue.h"
+
+#include <string>
+
+template class exemplar::SpscQueue<int>;
+template class exemplar::SpscQueue<std::string>;
@@ -0,0 +1,201 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+namespace exemplar {
+
+// A bounded lock-free FIFO for exactly one producer thread and one consumer
+// thread, such as two stages of a pipeline.
+//
+// The elements sit in a power-of-two ring. The producer owns tail_ and the
+// consumer owns head_; each index is written by one thread only, so a push
+// or pop is a plain store plus a release store, with no read-modify-write.
+//
+// The two indices live on separate cache lines, and each side keeps a
+// cached copy of the other side's index on its own line. The producer only
+// rereads head_ when its cached copy says the ring is full, and the
+// consumer only rereads tail_ when its copy says the ring is empty, so in
+// steady state the cache lines do not bounce between the two cores on
+// every operation.
+//
+// The try_ operations never block; callers decide whether to spin, yield
+// or do other work when the ring is full or empty. The bulk operations
+// move as many elements as fit and publish them with one store.
+//
+// Calling a producer operation from two threads at once, or a consumer
+// operation from two threads at once, is a data race.
+template <typename T>
+class SpscQueue {
+public:
+    using value_type = T;
+
+    // capacity is rounded up to a power of two.
+    explicit SpscQueue(std::size_t capacity) : capacity_(rounded_capacity(capacity)), mask_(capacity_ - 1) {
+        buffer_ = static_cast<T*>(::operator new(capacity_ * sizeof(T), std::align_val_t(alignof(T))));
+    }
+
+    // Both threads hold references to the ring.
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    ~SpscQueue() {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        for (std::size_t position = head_.load(std::memory_order_relaxed); position != tail; ++position) {
+            std::destroy_at(slot(position));
+        }
+        ::operator delete(buffer_, capacity_ * sizeof(T), std::align_val_t(alignof(T)));
+    }
+
+    [[nodiscard]] std::size_t capacity() const noexcept { return capacity_; }
+
+    [[nodiscard]] static constexpr std::size_t max_size() noexcept {
+        return std::bit_floor(static_cast<std::size_t>(PTRDIFF_MAX) / sizeof(T));
+    }
+
+    // Elements in the ring at some moment during the call. Exact only when
+    // called by the producer or the consumer while the other is idle.
+    [[nodiscard]] std::size_t size_approx() const noexcept {
+        const std::size_t head = head_.load(std::memory_order_acquire);
+        const std::size_t tail = tail_.load(std::memory_order_acquire);
+        return tail - head;
+    }
+
+    [[nodiscard]] bool empty_approx() const noexcept { return size_approx() == 0; }
+
+    // Producer. Returns false, leaving value untouched, when the ring is full.
+    bool try_push(const T& value) { return try_emplace(value); }
+    bool try_push(T&& value) { return try_emplace(std::move(value)); }
+
+    // Producer.
+    template <typename... Args>
+    bool try_emplace(Args&&... args) {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if (free_slots(tail) == 0) {
+            return false;
+        }
+
+        std::construct_at(slot(tail), std::forward<Args>(args)...);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Producer. Constructs up to count elements from first, first + 1, ...
+    // (use std::make_move_iterator to move them) and publishes them
+    // together. Returns how many fit. If a constructor throws, the elements
+    // built before it are published and the exception propagates.
+    template <std::input_iterator It>
+    std::size_t try_push_bulk(It first, std::size_t count) {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        const std::size_t accepted = std::min(count, free_slots(tail, count));
+
+        std::size_t built = 0;
+        try {
+            for (; built < accepted; ++built, ++first) {
+                std::construct_at(slot(tail + built), *first);
+            }
+        } catch (...) {
+            tail_.store(tail + built, std::memory_order_release);
+            throw;
+        }
+        tail_.store(tail + accepted, std::memory_order_release);
+        return accepted;
+    }
+
+    // Consumer. Returns false, leaving out untouched, when the ring is empty.
+    bool try_pop(T& out) {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        if (ready_slots(head) == 0) {
+            return false;
+        }
+
+        T* element = slot(head);
+        out = std::move(*element);
+        std::destroy_at(element);
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer. Moves up to max_count elements to out, in order, and frees
+    // their slots with one store. Returns how many were moved. If out
+    // throws, the elements moved before it are freed and the exception
+    // propagates.
+    template <std::output_iterator<T&&> Out>
+    std::size_t try_pop_bulk(Out out, std::size_t max_count) {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        const std::size_t taken = std::min(max_count, ready_slots(head, max_count));
+
+        std::size_t moved = 0;
+        try {
+            for (; moved < taken; ++moved, ++out) {
+                T* element = slot(head + moved);
+                *out = std::move(*element);
+                std::destroy_at(element);
+            }
+        } catch (...) {
+            head_.store(head + moved, std::memory_order_release);
+            throw;
+        }
+        head_.store(head + taken, std::memory_order_release);
+        return taken;
+    }
+
+private:
+    [[nodiscard]] static std::size_t rounded_capacity(std::size_t capacity) {
+        if (capacity > max_size()) {
+            throw std::length_error("SpscQueue capacity exceeds max_size");
+        }
+        return std::bit_ceil(std::max<std::size_t>(capacity, 2));
+    }
+
+    [[nodiscard]] T* slot(std::size_t position) const noexcept { return buffer_ + (position & mask_); }
+
+    // Producer side: free slots, rereading head_ only when the cached copy
+    // shows fewer than wanted. The acquire pairs with the consumer's
+    // release of head_, so the slots it freed are no longer being read.
+    [[nodiscard]] std::size_t free_slots(std::size_t tail, std::size_t wanted = 1) noexcept {
+        std::size_t free = capacity_ - (tail - cached_head_);
+        if (free < wanted) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            free = capacity_ - (tail - cached_head_);
+        }
+        return free;
+    }
+
+    // Consumer side: published elements, rereading tail_ only when the
+    // cached copy shows fewer than wanted. The acquire pairs with the
+    // producer's release of tail_, so the elements are fully constructed.
+    [[nodiscard]] std::size_t ready_slots(std::size_t head, std::size_t wanted = 1) noexcept {
+        std::size_t ready = cached_tail_ - head;
+        if (ready < wanted) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            ready = cached_tail_ - head;
+        }
+        return ready;
+    }
+
+    static constexpr std::size_t k_cache_line_size = 64;
+
+    // Read-only after construction; shared by both threads.
+    const std::size_t capacity_;
+    const std::size_t mask_;
+    T* buffer_{nullptr};
+
+    // Written by the consumer.
+    alignas(k_cache_line_size) std::atomic<std::size_t> head_{0};
+    std::size_t cached_tail_{0};
+
+    // Written by the producer. The alignment also rounds sizeof up to a
+    // whole line, so no neighbouring object shares it.
+    alignas(k_cache_line_size) std::atomic<std::size_t> tail_{0};
+    std::size_t cached_head_{0};
+};
+
+} // namespace exemplar
@@ -1,6 +1,9 @@
 #include "Stack.h"
 
+#include <memory_resource>
 #include <string>
 
 template class exemplar::Stack<int>;
 template class exemplar::Stack<std::string>;
+template class exemplar::Stack<std::pmr::string, std::pmr::polymorphic_allocator<std::pmr::string>>;
+template class exemplar::Stack<std::string, std::allocator<std::string>, exemplar::SegmentedArray<std::string>>;
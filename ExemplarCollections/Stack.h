@@ -1,8 +1,11 @@
 #pragma once
 
 #include "ResizingArray.h"
+#include "SegmentedArray.h"
 
 #include <cstddef>
+#include <memory>
+#include <memory_resource>
 #include <stdexcept>
 #include <utility>
 
@@ -10,11 +13,25 @@ namespace exemplar {
 
 // A simple LIFO stack that composes ResizingArray.
 // This shows a nice interview point: prefer composition over inheritance.
-template <typename T>
+// The allocator is simply handed to the underlying container.
+//
+// Like std::stack, the container is a parameter. Any sequence with
+// push_back, emplace_back, pop_back, back, clear and a constructor taking
+// the allocator will do; SegmentedStack below uses SegmentedArray, whose
+// elements never move, so references from top() and emplace() stay valid
+// while more elements are pushed.
+template <typename T, typename Allocator = std::allocator<T>, typename Container = ResizingArray<T, Allocator>>
 class Stack {
 public:
+    using allocator_type = Allocator;
+    using container_type = Container;
+
     Stack() = default;
 
+    explicit Stack(const Allocator& alloc) noexcept : items_(alloc) {}
+
+    [[nodiscard]] allocator_type get_allocator() const noexcept { return items_.get_allocator(); }
+
     [[nodiscard]] bool empty() const noexcept { return items_.empty(); }
     [[nodiscard]] std::size_t size() const noexcept { return items_.size(); }
 
@@ -50,7 +67,20 @@ public:
     void clear() noexcept { items_.clear(); }
 
 private:
-    ResizingArray<T> items_{};
+    Container items_{};
 };
 
+template <typename T, typename Allocator = std::allocator<T>>
+using SegmentedStack = Stack<T, Allocator, SegmentedArray<T, Allocator>>;
+
+namespace pmr {
+
+template <typename T>
+using Stack = exemplar::Stack<T, std::pmr::polymorphic_allocator<T>>;
+
+template <typename T>
+using SegmentedStack = exemplar::SegmentedStack<T, std::pmr::polymorphic_allocator<T>>;
+
+} // namespace pmr
+
 } // namespace exemplar
@@ -0,0 +1,150 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <utility>
+
+namespace exemplar {
+
+namespace {
+
+// The pool whose task the current thread is running, if any.
+thread_local const ThreadPool* t_running_pool = nullptr;
+
+} // namespace
+
+struct ThreadPool::Job {
+    const std::function<void(std::size_t)>* body;
+    std::size_t task_count;
+    std::atomic<std::size_t> next_task{0};
+
+    // Workers currently inside work_on(); guarded by ThreadPool::mutex_.
+    std::size_t active_workers{0};
+
+    std::mutex error_mutex{};
+    std::exception_ptr error{};
+};
+
+ThreadPool::ThreadPool(std::size_t thread_count) {
+    if (thread_count == 0) {
+        thread_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    workers_.reserve(thread_count - 1);
+    try {
+        for (std::size_t i = 1; i < thread_count; ++i) {
+            workers_.emplace_back([this] { worker_loop(); });
+        }
+    } catch (...) {
+        {
+            std::lock_guard lock(mutex_);
+            stopping_ = true;
+        }
+        work_available_.notify_all();
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+        throw;
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard lock(mutex_);
+        stopping_ = true;
+    }
+    work_available_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+ThreadPool& ThreadPool::global() {
+    static ThreadPool pool;
+    return pool;
+}
+
+void ThreadPool::run(std::size_t task_count, const std::function<void(std::size_t)>& body) {
+    if (task_count == 0) {
+        return;
+    }
+
+    if (workers_.empty() || task_count == 1 || t_running_pool == this) {
+        for (std::size_t i = 0; i < task_count; ++i) {
+            body(i);
+        }
+        return;
+    }
+
+    std::lock_guard run_lock(run_mutex_);
+    Job job{&body, task_count};
+
+    {
+        std::lock_guard lock(mutex_);
+        job_ = &job;
+        ++generation_;
+    }
+    work_available_.notify_all();
+
+    const ThreadPool* outer_pool = std::exchange(t_running_pool, this);
+    work_on(job);
+    t_running_pool = outer_pool;
+
+    {
+        // Workers that joined this job may still be finishing a task.
+        std::unique_lock lock(mutex_);
+        job_ = nullptr;
+        job_finished_.wait(lock, [&] { return job.active_workers == 0; });
+    }
+
+    if (job.error) {
+        std::rethrow_exception(job.error);
+    }
+}
+
+void ThreadPool::worker_loop() {
+    t_running_pool = this;
+    std::uint64_t seen_generation = 0;
+
+    std::unique_lock lock(mutex_);
+    while (true) {
+        work_available_.wait(lock, [&] { return stopping_ || (job_ != nullptr && generation_ != seen_generation); });
+        if (stopping_) {
+            return;
+        }
+
+        seen_generation = generation_;
+        Job& job = *job_;
+        ++job.active_workers;
+
+        lock.unlock();
+        work_on(job);
+        lock.lock();
+
+        if (--job.active_workers == 0) {
+            job_finished_.notify_all();
+        }
+    }
+}
+
+void ThreadPool::work_on(Job& job) {
+    while (true) {
+        const std::size_t task = job.next_task.fetch_add(1, std::memory_order_relaxed);
+        if (task >= job.task_count) {
+            return;
+        }
+
+        try {
+            (*job.body)(task);
+        } catch (...) {
+            std::lock_guard lock(job.error_mutex);
+            if (!job.error) {
+                job.error = std::current_exception();
+            }
+            // Skip the tasks nobody has claimed yet.
+            job.next_task.store(job.task_count, std::memory_order_relaxed);
+        }
+    }
+}
+
+} // namespace exemplar
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace exemplar {
+
+// A fixed set of worker threads that execute one batch of indexed tasks at
+// a time, for the data-parallel helpers in ParallelAlgorithms.h.
+//
+// run(task_count, body) calls body(0) ... body(task_count - 1). The workers
+// and the calling thread claim task indices from a shared atomic counter, so
+// faster threads simply take more tasks; the call returns once every task
+// has finished.
+//
+// Calls from inside a task (nested parallelism) run inline on the calling
+// worker. Concurrent calls from different outside threads take turns.
+class ThreadPool {
+public:
+    // thread_count counts the calling thread, so a pool of N starts N - 1
+    // workers. 0 means std::thread::hardware_concurrency().
+    explicit ThreadPool(std::size_t thread_count = 0);
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool();
+
+    // Shared pool with one thread per hardware thread, started on first use.
+    static ThreadPool& global();
+
+    [[nodiscard]] std::size_t thread_count() const noexcept { return workers_.size() + 1; }
+
+    // If a task throws, tasks not yet started are skipped and the first
+    // exception is rethrown here once the running ones have finished.
+    void run(std::size_t task_count, const std::function<void(std::size_t)>& body);
+
+private:
+    struct Job;
+
+    void worker_loop();
+    static void work_on(Job& job);
+
+    std::vector<std::thread> workers_;
+
+    // Serializes run() calls from different outside threads.
+    std::mutex run_mutex_;
+
+    std::mutex mutex_;
+    std::condition_variable work_available_;
+    std::condition_variable job_finished_;
+    Job* job_{nullptr};
+    std::uint64_t generation_{0};
+    bool stopping_{false};
+};
+
+} // namespace exemplar
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string_view>
+
+namespace exemplar {
+
+// A hash or comparator opts into heterogeneous lookup by declaring a nested
+// is_transparent type, the same convention std::unordered_map and std::map
+// use in C++20. Containers then accept any key type the functor accepts,
+// e.g. std::string_view or const char* for std::string keys, without
+// building a temporary key.
+template <typename Functor>
+concept transparent = requires { typename Functor::is_transparent; };
+
+// Transparent hash for std::string keys.
+// std::hash<std::string> and std::hash<std::string_view> agree on equal
+// character sequences, so hashing everything as a string_view is consistent.
+struct StringHash {
+    using is_transparent = void;
+
+    [[nodiscard]] std::size_t operator()(std::string_view text) const noexcept {
+        return std::hash<std::string_view>{}(text);
+    }
+};
+
+} // namespace exemplar
@@ -0,0 +1,4 @@
+#include "ChaseLevDeque.h"
+
+template class exemplar::ChaseLevDeque<int>;
+template class exemplar::ChaseLevDeque<void*>;
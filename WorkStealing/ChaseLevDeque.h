@@ -0,0 +1,166 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+namespace exemplar {
+
+// A growable work-stealing deque (Chase and Lev, 2005, with the C11 memory
+// orders of Le, Pop, Cohen and Zappa Nardelli, 2013).
+//
+// One owner thread pushes and pops at the bottom, LIFO, so it keeps working
+// on the task it spawned last, whose data is still in cache. Any other
+// thread may steal from the top, FIFO, taking the oldest task, which in a
+// divide-and-conquer computation is the largest piece of remaining work.
+//
+// push and pop touch only bottom_ in the common case; the owner and thieves
+// race only for the last element, which both sides settle with a
+// compare-exchange on top_. When the ring fills, the owner copies it into
+// one twice the size. Thieves may still be reading the old ring, so it is
+// kept until the deque is destroyed; all the rings together are at most
+// twice the largest.
+//
+// T is copied in and out of atomic slots, so it must be trivially copyable,
+// such as a pointer to a task.
+template <typename T>
+class ChaseLevDeque {
+    static_assert(std::is_trivially_copyable_v<T>, "slots are read by thieves racing with the owner");
+
+public:
+    using value_type = T;
+
+    // capacity is rounded up to a power of two.
+    explicit ChaseLevDeque(std::size_t capacity = k_default_capacity) {
+        auto ring = std::make_unique<Ring>(std::bit_ceil(std::max<std::size_t>(capacity, 2)));
+        ring_.store(ring.get(), std::memory_order_relaxed);
+        rings_.push_back(std::move(ring));
+    }
+
+    // Thieves hold references to the deque.
+    ChaseLevDeque(const ChaseLevDeque&) = delete;
+    ChaseLevDeque& operator=(const ChaseLevDeque&) = delete;
+
+    // Elements at some moment during the call.
+    [[nodiscard]] std::size_t size_approx() const noexcept {
+        const std::int64_t bottom = bottom_.load(std::memory_order_acquire);
+        const std::int64_t top = top_.load(std::memory_order_acquire);
+        return bottom > top ? static_cast<std::size_t>(bottom - top) : 0;
+    }
+
+    [[nodiscard]] bool empty_approx() const noexcept { return size_approx() == 0; }
+
+    // Owner only. Throws std::bad_alloc, leaving the deque unchanged, if
+    // the ring is full and cannot grow.
+    void push(T value) {
+        const std::int64_t bottom = bottom_.load(std::memory_order_relaxed);
+        const std::int64_t top = top_.load(std::memory_order_acquire);
+        Ring* ring = ring_.load(std::memory_order_relaxed);
+        if (bottom - top >= static_cast<std::int64_t>(ring->capacity())) {
+            ring = grow(ring, top, bottom);
+        }
+        ring->put(bottom, value);
+        // release: a thief that sees the new bottom also sees the slot and
+        // whatever value points to.
+        bottom_.store(bottom + 1, std::memory_order_release);
+    }
+
+    // Owner only. Takes the most recently pushed element.
+    std::optional<T> pop() {
+        const std::int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+        Ring* ring = ring_.load(std::memory_order_relaxed);
+        bottom_.store(bottom, std::memory_order_relaxed);
+        // Pairs with the fence in steal(): either the thief sees the
+        // lowered bottom, or this load sees the thief's raised top.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t top = top_.load(std::memory_order_relaxed);
+
+        if (top > bottom) {
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+            return std::nullopt;
+        }
+
+        std::optional<T> value = ring->get(bottom);
+        if (top == bottom) {
+            // The last element: a thief may be taking it too.
+            if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                value.reset();
+            }
+            bottom_.store(bottom + 1, std::memory_order_relaxed);
+        }
+        return value;
+    }
+
+    // Any thread. Takes the least recently pushed element. Returns nothing
+    // when the deque is empty or another thread took that element first.
+    std::optional<T> steal() {
+        std::int64_t top = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const std::int64_t bottom = bottom_.load(std::memory_order_acquire);
+        if (top >= bottom) {
+            return std::nullopt;
+        }
+
+        // Read before claiming: once top_ moves, the owner may reuse the slot.
+        const T value = ring_.load(std::memory_order_acquire)->get(top);
+        if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return std::nullopt;
+        }
+        return value;
+    }
+
+private:
+    static constexpr std::size_t k_default_capacity = 256;
+    static constexpr std::size_t k_cache_line_size = 64;
+
+    class Ring {
+    public:
+        explicit Ring(std::size_t capacity)
+            : mask_(capacity - 1), slots_(std::make_unique<std::atomic<T>[]>(capacity)) {}
+
+        [[nodiscard]] std::size_t capacity() const noexcept { return mask_ + 1; }
+
+        [[nodiscard]] T get(std::int64_t index) const noexcept {
+            return slots_[static_cast<std::size_t>(index) & mask_].load(std::memory_order_relaxed);
+        }
+
+        void put(std::int64_t index, T value) noexcept {
+            slots_[static_cast<std::size_t>(index) & mask_].store(value, std::memory_order_relaxed);
+        }
+
+    private:
+        std::size_t mask_;
+        std::unique_ptr<std::atomic<T>[]> slots_;
+    };
+
+    // Owner only: copies [top, bottom) into a ring twice the size and
+    // publishes it. The old ring stays in rings_ for thieves still reading it.
+    Ring* grow(Ring* ring, std::int64_t top, std::int64_t bottom) {
+        rings_.reserve(rings_.size() + 1);
+        auto bigger = std::make_unique<Ring>(ring->capacity() * 2);
+        for (std::int64_t i = top; i < bottom; ++i) {
+            bigger->put(i, ring->get(i));
+        }
+        Ring* published = bigger.get();
+        rings_.push_back(std::move(bigger));
+        ring_.store(published, std::memory_order_release);
+        return published;
+    }
+
+    // Written by thieves.
+    alignas(k_cache_line_size) std::atomic<std::int64_t> top_{0};
+
+    // Written by the owner.
+    alignas(k_cache_line_size) std::atomic<std::int64_t> bottom_{0};
+    std::atomic<Ring*> ring_{nullptr};
+    // Every ring allocated so far, the current one last. Owner only.
+    std::vector<std::unique_ptr<Ring>> rings_;
+};
+
+} // namespace exemplar
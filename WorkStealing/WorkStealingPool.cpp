@@ -0,0 +1,241 @@
+#include "WorkStealingPool.h"
+
+#include <functional>
+
+namespace exemplar {
+
+namespace {
+
+// The pool whose worker the current thread is, if any, and which worker.
+thread_local const WorkStealingPool* t_running_pool = nullptr;
+thread_local std::size_t t_worker_index = 0;
+
+// Per-thread xorshift state for picking steal victims.
+thread_local std::uint32_t t_victim_seed = 0;
+
+std::size_t random_below(std::size_t bound) noexcept {
+    std::uint32_t x = t_victim_seed;
+    if (x == 0) {
+        x = static_cast<std::uint32_t>(std::hash<std::thread::id>{}(std::this_thread::get_id())) | 1;
+    }
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    t_victim_seed = x;
+    return x % bound;
+}
+
+} // namespace
+
+struct alignas(64) WorkStealingPool::Worker {
+    ChaseLevDeque<detail::Task*> deque;
+    std::thread thread;
+};
+
+TaskGroup::~TaskGroup() { help_until_done(); }
+
+void TaskGroup::wait() {
+    help_until_done();
+    // fail() cancels the group after storing the error, before its task
+    // finishes, so the acquire of pending_ above makes this load exact.
+    if (!cancelled()) {
+        return;
+    }
+
+    std::exception_ptr error;
+    {
+        std::lock_guard lock(error_mutex_);
+        error = std::exchange(error_, nullptr);
+    }
+    cancelled_.store(false, std::memory_order_relaxed);
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+void TaskGroup::help_until_done() {
+    int idle_rounds = 0;
+    while (pending_.load(std::memory_order_acquire) != 0) {
+        if (detail::Task* task = pool_.find_task()) {
+            pool_.run_task(task);
+            idle_rounds = 0;
+            continue;
+        }
+        if (++idle_rounds < WorkStealingPool::k_idle_rounds) {
+            std::this_thread::yield();
+            continue;
+        }
+        idle_rounds = 0;
+
+        // Nothing to take: the group's remaining tasks are running on other
+        // threads. Sleep until one of them finishes the group, or new work
+        // is queued.
+        const EventCount::Key key = pool_.events_.prepare_wait();
+        if (pending_.load(std::memory_order_acquire) == 0) {
+            pool_.events_.cancel_wait();
+            return;
+        }
+        if (detail::Task* task = pool_.find_task()) {
+            pool_.events_.cancel_wait();
+            pool_.run_task(task);
+            continue;
+        }
+        pool_.events_.wait(key);
+    }
+}
+
+void TaskGroup::fail(std::exception_ptr error) noexcept {
+    {
+        std::lock_guard lock(error_mutex_);
+        if (!error_) {
+            error_ = std::move(error);
+        }
+    }
+    cancelled_.store(true, std::memory_order_relaxed);
+}
+
+WorkStealingPool::WorkStealingPool(std::size_t thread_count) {
+    if (thread_count == 0) {
+        thread_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // Every deque exists before any worker starts looking for victims.
+    workers_.reserve(thread_count);
+    for (std::size_t i = 0; i < thread_count; ++i) {
+        workers_.push_back(std::make_unique<Worker>());
+    }
+
+    try {
+        for (std::size_t i = 0; i < thread_count; ++i) {
+            workers_[i]->thread = std::thread([this, i] { worker_loop(i); });
+        }
+    } catch (...) {
+        stop_workers();
+        throw;
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() { stop_workers(); }
+
+void WorkStealingPool::stop_workers() noexcept {
+    stopping_.store(true, std::memory_order_relaxed);
+    events_.notify_all();
+    for (auto& worker : workers_) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+}
+
+void WorkStealingPool::push(detail::Task* task) {
+    if (t_running_pool == this) {
+        workers_[t_worker_index]->deque.push(task);
+    } else {
+        std::lock_guard lock(injected_mutex_);
+        injected_.enqueue(task);
+        injected_count_.store(injected_.size(), std::memory_order_relaxed);
+    }
+    events_.notify_one();
+}
+
+bool WorkStealingPool::local_queue_empty() const noexcept {
+    if (t_running_pool == this) {
+        return workers_[t_worker_index]->deque.empty_approx();
+    }
+    return injected_count_.load(std::memory_order_relaxed) == 0;
+}
+
+detail::Task* WorkStealingPool::find_task() {
+    Worker* self = t_running_pool == this ? workers_[t_worker_index].get() : nullptr;
+    if (self != nullptr) {
+        if (const auto task = self->deque.pop()) {
+            return *task;
+        }
+    }
+
+    if (injected_count_.load(std::memory_order_relaxed) != 0) {
+        std::lock_guard lock(injected_mutex_);
+        if (!injected_.empty()) {
+            detail::Task* task = injected_.front();
+            injected_.dequeue();
+            injected_count_.store(injected_.size(), std::memory_order_relaxed);
+            return task;
+        }
+    }
+
+    const std::size_t count = workers_.size();
+    std::size_t victim = random_below(count);
+    for (std::size_t i = 0; i < count; ++i, victim = victim + 1 == count ? 0 : victim + 1) {
+        Worker& worker = *workers_[victim];
+        if (&worker == self) {
+            continue;
+        }
+        // A failed steal means another thread won the race for the top
+        // task; the ones behind it are still there.
+        while (!worker.deque.empty_approx()) {
+            if (const auto task = worker.deque.steal()) {
+                return *task;
+            }
+        }
+    }
+    return nullptr;
+}
+
+detail::Task* WorkStealingPool::find_task_idle() {
+    for (int round = 0; round < k_idle_rounds; ++round) {
+        if (detail::Task* task = find_task()) {
+            return task;
+        }
+        std::this_thread::yield();
+    }
+    return nullptr;
+}
+
+void WorkStealingPool::run_task(detail::Task* task) noexcept {
+    TaskGroup* group = task->group();
+    if (group == nullptr) {
+        // A packaged_task: its exception goes to the future.
+        task->run();
+        delete task;
+        return;
+    }
+
+    if (!group->cancelled()) {
+        try {
+            task->run();
+        } catch (...) {
+            group->fail(std::current_exception());
+        }
+    }
+    // Captures die before the waiter can return and end their scope.
+    delete task;
+    if (group->finish_one()) {
+        events_.notify_all();
+    }
+}
+
+void WorkStealingPool::worker_loop(std::size_t index) {
+    t_running_pool = this;
+    t_worker_index = index;
+
+    for (;;) {
+        if (detail::Task* task = find_task_idle()) {
+            run_task(task);
+            continue;
+        }
+
+        const EventCount::Key key = events_.prepare_wait();
+        if (detail::Task* task = find_task()) {
+            events_.cancel_wait();
+            run_task(task);
+            continue;
+        }
+        if (stopping_.load(std::memory_order_relaxed)) {
+            events_.cancel_wait();
+            return;
+        }
+        events_.wait(key);
+    }
+}
+
+} // namespace exemplar
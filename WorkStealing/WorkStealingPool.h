@@ -0,0 +1,272 @@
+#pragma once
+
+#include "ChaseLevDeque.h"
+#include "EventCount.h"
+#include "RingQueue.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace exemplar {
+
+class TaskGroup;
+class WorkStealingPool;
+
+namespace detail {
+
+// A heap-allocated unit of work, owned by whichever queue holds it until a
+// thread takes it and runs it.
+class Task {
+public:
+    explicit Task(TaskGroup* group) noexcept : group_(group) {}
+    virtual ~Task() = default;
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    virtual void run() = 0;
+
+    // Null for tasks from submit(), whose result goes to a future instead.
+    [[nodiscard]] TaskGroup* group() const noexcept { return group_; }
+
+private:
+    TaskGroup* group_;
+};
+
+template <typename Fn>
+class FunctionTask final : public Task {
+public:
+    template <typename F>
+    FunctionTask(TaskGroup* group, F&& fn) : Task(group), fn_(std::forward<F>(fn)) {}
+
+    void run() override { fn_(); }
+
+private:
+    Fn fn_;
+};
+
+} // namespace detail
+
+// Fork/join on a WorkStealingPool: spawn() any number of tasks, which may
+// themselves spawn into the same group, then wait() for all of them.
+//
+//     TaskGroup group(pool);
+//     group.spawn([&] { sort(left); });
+//     sort(right);
+//     group.wait();
+//
+// wait() does not block while there is work: it runs the caller's own
+// spawned tasks, then steals from the workers, and sleeps only once there
+// is nothing left to take.
+//
+// If a task throws, tasks of the group not yet started are skipped, and
+// wait() rethrows the first exception once the running ones have finished.
+// The group can be reused after wait() returns or throws.
+class TaskGroup {
+public:
+    explicit TaskGroup(WorkStealingPool& pool) noexcept : pool_(pool) {}
+
+    // Tasks hold a pointer to the group.
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    // Waits for the tasks still running. An exception one of them threw is
+    // dropped; call wait() first to see it.
+    ~TaskGroup();
+
+    // Queues fn() to run on the pool. Called from a task of the pool, the
+    // task goes to that worker's own deque; from any other thread, to the
+    // pool's shared queue.
+    template <typename F>
+    void spawn(F&& fn);
+
+    // Returns once every spawned task has finished, running tasks itself
+    // in the meantime.
+    void wait();
+
+private:
+    friend class WorkStealingPool;
+
+    // Runs tasks until pending_ drops to zero.
+    void help_until_done();
+
+    // A task of this group threw: keep the first exception and skip the
+    // tasks nobody has started yet.
+    void fail(std::exception_ptr error) noexcept;
+
+    // Returns true for the group's last outstanding task. Must be the last
+    // access to the group: the waiter may return and destroy it as soon as
+    // pending_ reaches zero.
+    [[nodiscard]] bool finish_one() noexcept { return pending_.fetch_sub(1, std::memory_order_acq_rel) == 1; }
+
+    [[nodiscard]] bool cancelled() const noexcept { return cancelled_.load(std::memory_order_relaxed); }
+
+    WorkStealingPool& pool_;
+    std::atomic<std::size_t> pending_{0};
+    std::atomic<bool> cancelled_{false};
+    std::mutex error_mutex_;
+    std::exception_ptr error_;
+};
+
+// A fixed set of worker threads, each with its own ChaseLevDeque of tasks,
+// for irregular and recursive parallelism: tasks that spawn tasks.
+//
+// A worker pushes the tasks it spawns onto its own deque and pops them
+// back LIFO, so most tasks run where their data is already cached and no
+// other thread is involved. A worker that runs dry steals the oldest task
+// from a random other worker, which in a divide-and-conquer computation is
+// the biggest piece left, so steals are rare. Threads outside the pool
+// hand work in through one shared, mutex-guarded queue.
+//
+// Idle workers spin briefly and then sleep on an EventCount, so pushing a
+// task makes no syscall while every worker is busy.
+//
+// Compared with ThreadPool, which runs one flat batch of indexed tasks at a
+// time, this pool runs any number of independent submissions and nested
+// TaskGroups at once; nested waits help instead of running inline.
+class WorkStealingPool {
+public:
+    // Starts thread_count workers. 0 means std::thread::hardware_concurrency().
+    // A thread outside the pool that calls TaskGroup::wait() or
+    // parallel_for() also runs tasks while it waits.
+    explicit WorkStealingPool(std::size_t thread_count = 0);
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    // Runs every task already queued, then stops the workers. No TaskGroup
+    // may still be waiting on the pool.
+    ~WorkStealingPool();
+
+    [[nodiscard]] std::size_t thread_count() const noexcept { return workers_.size(); }
+
+    // Queues fn() and returns a future for its result, or for the
+    // exception it throws.
+    template <typename F>
+    [[nodiscard]] std::future<std::invoke_result_t<std::decay_t<F>&>> submit(F&& fn) {
+        using Result = std::invoke_result_t<std::decay_t<F>&>;
+        std::packaged_task<Result()> job(std::forward<F>(fn));
+        std::future<Result> result = job.get_future();
+        push_new(nullptr, std::move(job));
+        return result;
+    }
+
+    // Calls body(i) for every i in [first, last), then returns.
+    //
+    // The range is split lazily rather than cut into a fixed number of
+    // chunks up front: the task running a range works through it grain
+    // indices at a time, and before each step, if its worker's deque is
+    // empty (any queued work has been stolen, so other threads are
+    // hungry), it splits off the upper half as a new task. Busy pools
+    // split little and keep per-task overhead low; idle workers get work
+    // within one grain. grain only needs to amortize one check of the
+    // local deque, so it can be much smaller than ThreadPool's chunks.
+    //
+    // If body throws, indices not yet reached are skipped and the first
+    // exception is rethrown here.
+    template <typename Body>
+    void parallel_for(std::size_t first, std::size_t last, Body&& body, std::size_t grain = 1) {
+        if (first >= last) {
+            return;
+        }
+
+        TaskGroup group(*this);
+        try {
+            run_range(group, first, last, std::max<std::size_t>(grain, 1), body);
+        } catch (...) {
+            group.fail(std::current_exception());
+        }
+        group.wait();
+    }
+
+private:
+    friend class TaskGroup;
+
+    struct Worker;
+
+    // Idle rounds (a full search for a task, then a yield) before a
+    // thread without work goes to sleep.
+    static constexpr int k_idle_rounds = 64;
+
+    template <typename F>
+    void push_new(TaskGroup* group, F&& fn) {
+        auto task = std::make_unique<detail::FunctionTask<std::decay_t<F>>>(group, std::forward<F>(fn));
+        push(task.get());
+        task.release();
+    }
+
+    template <typename Body>
+    void run_range(TaskGroup& group, std::size_t first, std::size_t last, std::size_t grain, Body& body) {
+        while (first < last && !group.cancelled()) {
+            if (last - first > grain && local_queue_empty()) {
+                const std::size_t middle = first + (last - first) / 2;
+                group.spawn([this, &group, &body, middle, last, grain] {
+                    run_range(group, middle, last, grain, body);
+                });
+                last = middle;
+                continue;
+            }
+
+            const std::size_t step_end = std::min(last - first, grain) + first;
+            for (; first < step_end; ++first) {
+                body(first);
+            }
+        }
+    }
+
+    // Takes ownership of task and queues it on the calling worker's deque,
+    // or on the shared queue when called from outside the pool.
+    void push(detail::Task* task);
+
+    // The calling worker's deque, or the shared queue from outside the
+    // pool, has nothing waiting to be taken.
+    [[nodiscard]] bool local_queue_empty() const noexcept;
+
+    // The calling worker's own deque first, then the shared queue, then
+    // the other workers starting from a random one. Null if all are empty.
+    [[nodiscard]] detail::Task* find_task();
+
+    // As find_task(), retrying for k_idle_rounds before giving up.
+    [[nodiscard]] detail::Task* find_task_idle();
+
+    // Runs task and deletes it, then settles its group.
+    void run_task(detail::Task* task) noexcept;
+
+    void worker_loop(std::size_t index);
+    void stop_workers() noexcept;
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+
+    std::mutex injected_mutex_;
+    RingQueue<detail::Task*> injected_;
+    // injected_.size(), readable without the lock.
+    std::atomic<std::size_t> injected_count_{0};
+
+    // Notified when a task is queued (one sleeper) and when a group's last
+    // task finishes (every sleeper, since only its waiter cares).
+    EventCount events_;
+    std::atomic<bool> stopping_{false};
+};
+
+template <typename F>
+void TaskGroup::spawn(F&& fn) {
+    pending_.fetch_add(1, std::memory_order_relaxed);
+    try {
+        pool_.push_new(this, std::forward<F>(fn));
+    } catch (...) {
+        pending_.fetch_sub(1, std::memory_order_relaxed);
+        throw;
+    }
+}
+
+} // namespace exemplar